@@ -184,6 +184,12 @@ static struct usb_device_id blacklist_table[] = {
 
 #define BTUSB_MAX_ISOC_FRAMES	10
 
+/* The bulk-in URB pool grows by one when a whole pool's worth of
+ * completions came back to back, and gives one up after being idle */
+#define BTUSB_MIN_BULK_URBS	2
+#define BTUSB_MAX_BULK_URBS	8
+#define BTUSB_BULK_IDLE		(HZ / 2)
+
 #define BTUSB_INTR_RUNNING	0
 #define BTUSB_BULK_RUNNING	1
 #define BTUSB_ISOC_RUNNING	2
@@ -211,6 +217,10 @@ struct btusb_data {
 	int tx_in_flight;
 	spinlock_t txlock;
 
+	atomic_t bulk_urbs;
+	unsigned int bulk_streak;
+	unsigned long bulk_last_rx;
+
 	struct usb_endpoint_descriptor *intr_ep;
 	struct usb_endpoint_descriptor *bulk_tx_ep;
 	struct usb_endpoint_descriptor *bulk_rx_ep;
@@ -326,9 +336,54 @@ static int btusb_submit_intr_urb(struct hci_dev *hdev, gfp_t mem_flags)
 	return err;
 }
 
+static int btusb_submit_bulk_urb(struct hci_dev *hdev, gfp_t mem_flags);
+
+/* A buffer that holds exactly one whole ACL packet, with nothing of an
+ * earlier one pending, is the packet itself and goes up as it is */
+static bool btusb_bulk_whole_frame(struct hci_dev *hdev, struct sk_buff *skb,
+							unsigned int len)
+{
+	struct hci_acl_hdr *hdr = (void *) skb->data;
+
+	if (hdev->reassembly[HCI_ACLDATA_PKT - 1])
+		return false;
+
+	return len >= HCI_ACL_HDR_SIZE &&
+			len == HCI_ACL_HDR_SIZE + __le16_to_cpu(hdr->dlen);
+}
+
+/* Grow the pool when it runs dry, shrink it when it sits idle. Returns
+ * false if this URB should be given up rather than resubmitted. */
+static bool btusb_bulk_adapt(struct hci_dev *hdev)
+{
+	struct btusb_data *data = hdev->driver_data;
+	unsigned long gap = jiffies - data->bulk_last_rx;
+	int urbs = atomic_read(&data->bulk_urbs);
+
+	data->bulk_last_rx = jiffies;
+
+	if (gap > BTUSB_BULK_IDLE) {
+		data->bulk_streak = 0;
+		return urbs <= BTUSB_MIN_BULK_URBS;
+	}
+
+	if (gap > 1) {
+		data->bulk_streak = 0;
+		return true;
+	}
+
+	if (++data->bulk_streak >= urbs && urbs < BTUSB_MAX_BULK_URBS) {
+		data->bulk_streak = 0;
+		btusb_submit_bulk_urb(hdev, GFP_ATOMIC);
+	}
+
+	return true;
+}
+
 static void btusb_bulk_complete(struct urb *urb)
 {
-	struct hci_dev *hdev = urb->context;
+	struct sk_buff *skb = urb->context;
+	struct hci_dev *hdev = (void *) skb->dev;
 	struct btusb_data *data = hdev->driver_data;
 	int err;
 
@@ -336,13 +391,25 @@ static void btusb_bulk_complete(struct urb *urb)
 					urb, urb->status, urb->actual_length);
 
 	if (!test_bit(HCI_RUNNING, &hdev->flags))
-		return;
+		goto drop;
 
 	if (urb->status == 0) {
 		hdev->stat.byte_rx += urb->actual_length;
 
-		if (hci_recv_fragment(hdev, HCI_ACLDATA_PKT,
-						urb->transfer_buffer,
+		if (btusb_bulk_whole_frame(hdev, skb, urb->actual_length)) {
+			skb_put(skb, urb->actual_length);
+			bt_cb(skb)->pkt_type = HCI_ACLDATA_PKT;
+			hci_recv_frame(skb);
+
+			skb = bt_skb_alloc(HCI_MAX_FRAME_SIZE, GFP_ATOMIC);
+			if (!skb)
+				goto drop;
+
+			skb->dev = (void *) hdev;
+			urb->context = skb;
+			urb->transfer_buffer = skb->data;
+		} else if (hci_recv_fragment(hdev, HCI_ACLDATA_PKT,
+						skb->data,
 						urb->actual_length) < 0) {
 			BT_ERR("%s corrupted ACL packet", hdev->name);
 			hdev->stat.err_rx++;
@@ -350,7 +417,10 @@ static void btusb_bulk_complete(struct urb *urb)
 	}
 
 	if (!test_bit(BTUSB_BULK_RUNNING, &data->flags))
-		return;
+		goto drop;
+
+	if (urb->status == 0 && !btusb_bulk_adapt(hdev))
+		goto drop;
 
 	usb_anchor_urb(urb, &data->bulk_anchor);
 	usb_mark_last_busy(data->udev);
@@ -363,14 +433,21 @@ static void btusb_bulk_complete(struct urb *urb)
 			BT_ERR("%s urb %p failed to resubmit (%d)",
 						hdev->name, urb, -err);
 		usb_unanchor_urb(urb);
+		goto drop;
 	}
+
+	return;
+
+drop:
+	kfree_skb(skb);
+	atomic_dec(&data->bulk_urbs);
 }
 
 static int btusb_submit_bulk_urb(struct hci_dev *hdev, gfp_t mem_flags)
 {
 	struct btusb_data *data = hdev->driver_data;
 	struct urb *urb;
-	unsigned char *buf;
+	struct sk_buff *skb;
 	unsigned int pipe;
 	int err, size = HCI_MAX_FRAME_SIZE;
 
@@ -383,28 +460,32 @@ static int btusb_submit_bulk_urb(struct hci_dev *hdev, gfp_t mem_flags)
 	if (!urb)
 		return -ENOMEM;
 
-	buf = kmalloc(size, mem_flags);
-	if (!buf) {
+	skb = bt_skb_alloc(size, mem_flags);
+	if (!skb) {
 		usb_free_urb(urb);
 		return -ENOMEM;
 	}
 
+	skb->dev = (void *) hdev;
+
 	pipe = usb_rcvbulkpipe(data->udev, data->bulk_rx_ep->bEndpointAddress);
 
 	usb_fill_bulk_urb(urb, data->udev, pipe,
-					buf, size, btusb_bulk_complete, hdev);
-
-	urb->transfer_flags |= URB_FREE_BUFFER;
+				skb->data, size, btusb_bulk_complete, skb);
 
 	usb_mark_last_busy(data->udev);
 	usb_anchor_urb(urb, &data->bulk_anchor);
 
+	atomic_inc(&data->bulk_urbs);
+
 	err = usb_submit_urb(urb, mem_flags);
 	if (err < 0) {
 		if (err != -EPERM && err != -ENODEV)
 			BT_ERR("%s urb %p submission failed (%d)",
 						hdev->name, urb, -err);
 		usb_unanchor_urb(urb);
+		atomic_dec(&data->bulk_urbs);
+		kfree_skb(skb);
 	}
 
 	usb_free_urb(urb);
@@ -421,53 +421,85 @@ static void bcsp_handle_le_pkt(struct hci_uart *hu)
 	}
 }
 
-static inline void bcsp_unslip_one_byte(struct bcsp_struct *bcsp, unsigned char byte)
+/* SLIP classes of received bytes */
+enum {
+	BCSP_SLIP_PLAIN = 0,
+	BCSP_SLIP_ESC,
+	BCSP_SLIP_END
+};
+
+static const u8 bcsp_slip_class[256] = {
+	[0xc0] = BCSP_SLIP_END,
+	[0xdb] = BCSP_SLIP_ESC,
+};
+
+/* What a byte following 0xdb stands for, 0 if it may not follow it */
+static const u8 bcsp_slip_unesc[256] = {
+	[0xdc] = 0xc0,
+	[0xdd] = 0xdb,
+};
+
+static void bcsp_unslip_put(struct bcsp_struct *bcsp, const u8 *data, int len)
 {
-	const u8 c0 = 0xc0, db = 0xdb;
+	int i;
 
-	switch (bcsp->rx_esc_state) {
-	case BCSP_ESCSTATE_NOESC:
-		switch (byte) {
-		case 0xdb:
-			bcsp->rx_esc_state = BCSP_ESCSTATE_ESC;
-			break;
-		default:
-			memcpy(skb_put(bcsp->rx_skb, 1), &byte, 1);
-			if ((bcsp->rx_skb-> data[0] & 0x40) != 0 && 
-					bcsp->rx_state != BCSP_W4_CRC)
-				bcsp_crc_update(&bcsp->message_crc, byte);
-			bcsp->rx_count--;
-		}
-		break;
+	memcpy(skb_put(bcsp->rx_skb, len), data, len);
 
-	case BCSP_ESCSTATE_ESC:
-		switch (byte) {
-		case 0xdc:
-			memcpy(skb_put(bcsp->rx_skb, 1), &c0, 1);
-			if ((bcsp->rx_skb-> data[0] & 0x40) != 0 && 
-					bcsp->rx_state != BCSP_W4_CRC)
-				bcsp_crc_update(&bcsp-> message_crc, 0xc0);
-			bcsp->rx_esc_state = BCSP_ESCSTATE_NOESC;
-			bcsp->rx_count--;
+	if ((bcsp->rx_skb->data[0] & 0x40) != 0 &&
+			bcsp->rx_state != BCSP_W4_CRC)
+		for (i = 0; i < len; i++)
+			bcsp_crc_update(&bcsp->message_crc, data[i]);
+
+	bcsp->rx_count -= len;
+}
+
+/*
+   Unslip up to rx_count bytes into rx_skb, stopping in front of a
+   delimiter. Runs of plain bytes are copied in one go.
+   Returns the number of input bytes consumed.
+*/
+static int bcsp_unslip(struct bcsp_struct *bcsp, const u8 *ptr, int count)
+{
+	const u8 *p = ptr, *end = ptr + count;
+	int n, limit;
+	u8 byte;
+
+	while (p < end && bcsp->rx_count) {
+		if (bcsp_slip_class[*p] == BCSP_SLIP_END)
 			break;
 
-		case 0xdd:
-			memcpy(skb_put(bcsp->rx_skb, 1), &db, 1);
-			if ((bcsp->rx_skb-> data[0] & 0x40) != 0 && 
-					bcsp->rx_state != BCSP_W4_CRC) 
-				bcsp_crc_update(&bcsp-> message_crc, 0xdb);
+		if (bcsp->rx_esc_state == BCSP_ESCSTATE_ESC) {
+			byte = bcsp_slip_unesc[*p];
+			if (!byte) {
+				BT_ERR ("Invalid byte %02x after esc byte", *p);
+				kfree_skb(bcsp->rx_skb);
+				bcsp->rx_skb = NULL;
+				bcsp->rx_state = BCSP_W4_PKT_DELIMITER;
+				bcsp->rx_count = 0;
+				return p + 1 - ptr;
+			}
 			bcsp->rx_esc_state = BCSP_ESCSTATE_NOESC;
-			bcsp->rx_count--;
-			break;
+			bcsp_unslip_put(bcsp, &byte, 1);
+			p++;
+			continue;
+		}
 
-		default:
-			BT_ERR ("Invalid byte %02x after esc byte", byte);
-			kfree_skb(bcsp->rx_skb);
-			bcsp->rx_skb = NULL;
-			bcsp->rx_state = BCSP_W4_PKT_DELIMITER;
-			bcsp->rx_count = 0;
+		if (bcsp_slip_class[*p] == BCSP_SLIP_ESC) {
+			bcsp->rx_esc_state = BCSP_ESCSTATE_ESC;
+			p++;
+			continue;
 		}
+
+		limit = min_t(long, end - p, bcsp->rx_count);
+		for (n = 1; n < limit; n++)
+			if (bcsp_slip_class[p[n]] != BCSP_SLIP_PLAIN)
+				break;
+
+		bcsp_unslip_put(bcsp, p, n);
+		p += n;
 	}
+
+	return p - ptr;
 }
 
 static void bcsp_complete_rx_pkt(struct hci_uart *hu)
@@ -553,6 +585,7 @@ static int bcsp_recv(struct hci_uart *hu, void *data, int count)
 {
 	struct bcsp_struct *bcsp = hu->priv;
 	register unsigned char *ptr;
+	int len;
 
 	BT_DBG("hu %p count %d rx_state %d rx_count %ld", 
 		hu, count, bcsp->rx_state, bcsp->rx_count);
@@ -565,10 +598,12 @@ static int bcsp_recv(struct hci_uart *hu, void *data, int count)
 				kfree_skb(bcsp->rx_skb);
 				bcsp->rx_state = BCSP_W4_PKT_START;
 				bcsp->rx_count = 0;
-			} else
-				bcsp_unslip_one_byte(bcsp, *ptr);
+				ptr++; count--;
+				continue;
+			}
 
-			ptr++; count--;
+			len = bcsp_unslip(bcsp, ptr, count);
+			ptr += len; count -= len;
 			continue;
 		}
 
@@ -45,6 +45,7 @@
 #include <linux/signal.h>
 #include <linux/ioctl.h>
 #include <linux/skbuff.h>
+#include <asm/unaligned.h>
 
 #include <net/bluetooth/bluetooth.h>
 #include <net/bluetooth/hci_core.h>
@@ -485,8 +486,25 @@ static int ll_recv(struct hci_uart *hu, void *data, int count)
 
 		ptr++; count--;
 
-		/* Allocate packet */
-		ll->rx_skb = bt_skb_alloc(HCI_MAX_FRAME_SIZE, GFP_ATOMIC);
+		/* Allocate packet, exactly sized if its header is all here */
+		len = HCI_MAX_FRAME_SIZE;
+		if (count >= ll->rx_count) {
+			switch (type) {
+			case HCI_EVENT_PKT:
+				dlen = ((struct hci_event_hdr *) ptr)->plen;
+				break;
+			case HCI_ACLDATA_PKT:
+				dlen = get_unaligned_le16(
+					&((struct hci_acl_hdr *) ptr)->dlen);
+				break;
+			default:
+				dlen = ((struct hci_sco_hdr *) ptr)->dlen;
+				break;
+			}
+			len = min_t(int, len, ll->rx_count + dlen);
+		}
+
+		ll->rx_skb = bt_skb_alloc(len, GFP_ATOMIC);
 		if (!ll->rx_skb) {
 			BT_ERR("Can't allocate mem for new packet");
 			ll->rx_state = HCILL_W4_PACKET_TYPE;
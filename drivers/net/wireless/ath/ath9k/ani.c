@@ -109,14 +109,62 @@ static bool use_new_ani(struct ath_hw *ah)
 	return AR_SREV_9300_20_OR_LATER(ah) || modparam_force_new_ani;
 }
 
+/*
+ * MIB and PHY error counters are fetched with a single multi-register
+ * read so that ath9k_htc needs one WMI round trip instead of one per
+ * counter. The PHY error counters are optional and come last.
+ */
+enum ath9k_mib_counter {
+	ATH9K_MIB_ACK_FAIL,
+	ATH9K_MIB_RTS_FAIL,
+	ATH9K_MIB_FCS_FAIL,
+	ATH9K_MIB_RTS_OK,
+	ATH9K_MIB_BEACON_CNT,
+	ATH9K_MIB_PHY_ERR_1,
+	ATH9K_MIB_PHY_ERR_2,
+	ATH9K_MIB_MAX
+};
+
+static const u32 ath9k_mib_counter_regs[ATH9K_MIB_MAX] = {
+	[ATH9K_MIB_ACK_FAIL]	= AR_ACK_FAIL,
+	[ATH9K_MIB_RTS_FAIL]	= AR_RTS_FAIL,
+	[ATH9K_MIB_FCS_FAIL]	= AR_FCS_FAIL,
+	[ATH9K_MIB_RTS_OK]	= AR_RTS_OK,
+	[ATH9K_MIB_BEACON_CNT]	= AR_BEACON_CNT,
+	[ATH9K_MIB_PHY_ERR_1]	= AR_PHY_ERR_1,
+	[ATH9K_MIB_PHY_ERR_2]	= AR_PHY_ERR_2,
+};
+
+static void ath9k_hw_read_mibstats(struct ath_hw *ah,
+				   struct ath9k_mib_stats *stats,
+				   u32 *phyCnt1, u32 *phyCnt2)
+{
+	u32 addr[ATH9K_MIB_MAX];
+	u32 data[ATH9K_MIB_MAX];
+	u16 count = ATH9K_MIB_PHY_ERR_1;
+
+	if (phyCnt1 && phyCnt2)
+		count = ATH9K_MIB_MAX;
+
+	memcpy(addr, ath9k_mib_counter_regs, sizeof(u32) * count);
+	REG_READ_MULTI(ah, addr, data, count);
+
+	stats->ackrcv_bad += data[ATH9K_MIB_ACK_FAIL];
+	stats->rts_bad += data[ATH9K_MIB_RTS_FAIL];
+	stats->fcs_bad += data[ATH9K_MIB_FCS_FAIL];
+	stats->rts_good += data[ATH9K_MIB_RTS_OK];
+	stats->beacons += data[ATH9K_MIB_BEACON_CNT];
+
+	if (count == ATH9K_MIB_MAX) {
+		*phyCnt1 = data[ATH9K_MIB_PHY_ERR_1];
+		*phyCnt2 = data[ATH9K_MIB_PHY_ERR_2];
+	}
+}
+
 static void ath9k_hw_update_mibstats(struct ath_hw *ah,
 				     struct ath9k_mib_stats *stats)
 {
-	stats->ackrcv_bad += REG_READ(ah, AR_ACK_FAIL);
-	stats->rts_bad += REG_READ(ah, AR_RTS_FAIL);
-	stats->fcs_bad += REG_READ(ah, AR_FCS_FAIL);
-	stats->rts_good += REG_READ(ah, AR_RTS_OK);
-	stats->beacons += REG_READ(ah, AR_BEACON_CNT);
+	ath9k_hw_read_mibstats(ah, stats, NULL, NULL);
 }
 
 static void ath9k_ani_restart(struct ath_hw *ah)
@@ -655,10 +703,7 @@ static bool ath9k_hw_ani_read_counters(struct ath_hw *ah)
 
 	aniState->listenTime += listenTime;
 
-	ath9k_hw_update_mibstats(ah, &ah->ah_mibStats);
-
-	phyCnt1 = REG_READ(ah, AR_PHY_ERR_1);
-	phyCnt2 = REG_READ(ah, AR_PHY_ERR_2);
+	ath9k_hw_read_mibstats(ah, &ah->ah_mibStats, &phyCnt1, &phyCnt2);
 
 	if (!use_new_ani(ah) && (phyCnt1 < ofdm_base || phyCnt2 < cck_base)) {
 		if (phyCnt1 < ofdm_base) {
@@ -795,8 +840,11 @@ void ath9k_hw_proc_mib_event(struct ath_hw *ah)
 	if (!(REG_READ(ah, AR_SLP_MIB_CTRL) & AR_SLP_MIB_PENDING))
 		REG_WRITE(ah, AR_SLP_MIB_CTRL, AR_SLP_MIB_CLEAR);
 
-	/* Clear the mib counters and save them in the stats */
-	ath9k_hw_update_mibstats(ah, &ah->ah_mibStats);
+	/*
+	 * Clear the mib counters and save them in the stats.
+	 * NB: the phy error counters are not reset-on-read.
+	 */
+	ath9k_hw_read_mibstats(ah, &ah->ah_mibStats, &phyCnt1, &phyCnt2);
 
 	if (!DO_ANI(ah)) {
 		/*
@@ -808,9 +856,6 @@ void ath9k_hw_proc_mib_event(struct ath_hw *ah)
 		return;
 	}
 
-	/* NB: these are not reset-on-read */
-	phyCnt1 = REG_READ(ah, AR_PHY_ERR_1);
-	phyCnt2 = REG_READ(ah, AR_PHY_ERR_2);
 	if (((phyCnt1 & AR_MIBCNT_INTRMASK) == AR_MIBCNT_INTRMASK) ||
 	    ((phyCnt2 & AR_MIBCNT_INTRMASK) == AR_MIBCNT_INTRMASK)) {
 
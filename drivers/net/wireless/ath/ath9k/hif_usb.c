@@ -240,6 +240,31 @@ static inline void ath9k_skb_queue_complete(struct hif_device_usb *hif_dev,
 	}
 }
 
+static inline u8 hif_usb_tx_inflight(struct hif_device_usb *hif_dev)
+{
+	return MAX_TX_URB_NUM - hif_dev->tx.tx_buf_cnt;
+}
+
+/*
+ * Adapt the number of TX URBs kept in flight. While a full aggregate is
+ * still waiting when an URB completes, the bus is the bottleneck and one
+ * more URB is allowed; once the backlog has drained, or on an error, the
+ * limit falls back so that frames are aggregated again instead of being
+ * spread thinly over many small transfers. TX lock has to be taken.
+ */
+static void __hif_usb_tx_adapt(struct hif_device_usb *hif_dev, bool txok)
+{
+	struct hif_usb_tx *tx = &hif_dev->tx;
+
+	if (!txok)
+		tx->tx_urb_limit = 1;
+	else if (tx->tx_skb_cnt >= MAX_TX_AGGR_NUM)
+		tx->tx_urb_limit = min_t(u8, tx->tx_urb_limit + 1,
+					 MAX_TX_URB_NUM);
+	else if (!tx->tx_skb_cnt && tx->tx_urb_limit > 1)
+		tx->tx_urb_limit--;
+}
+
 static void hif_usb_tx_cb(struct urb *urb)
 {
 	struct tx_buf *tx_buf = (struct tx_buf *) urb->context;
@@ -288,8 +313,14 @@ static void hif_usb_tx_cb(struct urb *urb)
 	spin_lock(&hif_dev->tx.tx_lock);
 	list_move_tail(&tx_buf->list, &hif_dev->tx.tx_buf);
 	hif_dev->tx.tx_buf_cnt++;
-	if (!(hif_dev->tx.flags & HIF_USB_TX_STOP))
-		__hif_usb_tx(hif_dev); /* Check for pending SKBs */
+	__hif_usb_tx_adapt(hif_dev, txok);
+	if (!(hif_dev->tx.flags & HIF_USB_TX_STOP)) {
+		/* Check for pending SKBs */
+		while (hif_dev->tx.tx_skb_cnt &&
+		       hif_usb_tx_inflight(hif_dev) < hif_dev->tx.tx_urb_limit)
+			if (__hif_usb_tx(hif_dev))
+				break;
+	}
 	TX_STAT_INC(buf_completed);
 	spin_unlock(&hif_dev->tx.tx_lock);
 }
@@ -405,6 +436,10 @@ static int hif_usb_send_tx(struct hif_device_usb *hif_dev, struct sk_buff *skb)
 	if ((hif_dev->tx.tx_buf_cnt == MAX_TX_URB_NUM) &&
 	    (hif_dev->tx.tx_skb_cnt < 2)) {
 		__hif_usb_tx(hif_dev);
+	} else if ((hif_dev->tx.tx_skb_cnt >= MAX_TX_AGGR_NUM) &&
+		   (hif_usb_tx_inflight(hif_dev) < hif_dev->tx.tx_urb_limit)) {
+		/* A full aggregate is ready, pipeline it behind the others */
+		__hif_usb_tx(hif_dev);
 	}
 
 	spin_unlock_irqrestore(&hif_dev->tx.tx_lock, flags);
@@ -566,7 +601,12 @@ static void ath9k_hif_usb_rx_stream(struct hif_device_usb *hif_dev,
 
 		if (pkt_tag != ATH_USB_RX_STREAM_MODE_TAG) {
 			RX_STAT_INC(skb_dropped);
-			return;
+			goto err;
+		}
+
+		if (pool_index == MAX_PKT_NUM_IN_TRANSFER) {
+			RX_STAT_INC(skb_dropped);
+			goto err;
 		}
 
 		pad_len = 4 - (pkt_len & 0x3);
@@ -796,6 +836,7 @@ static int ath9k_hif_usb_alloc_tx_urbs(struct hif_device_usb *hif_dev)
 	}
 
 	hif_dev->tx.tx_buf_cnt = MAX_TX_URB_NUM;
+	hif_dev->tx.tx_urb_limit = 1;
 
 	return 0;
 err:
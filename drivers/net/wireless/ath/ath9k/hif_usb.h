@@ -72,6 +72,7 @@ struct tx_buf {
 struct hif_usb_tx {
 	u8 flags;
 	u8 tx_buf_cnt;
+	u8 tx_urb_limit;	/* TX URBs allowed in flight, adapted */
 	u16 tx_skb_cnt;
 	struct sk_buff_head tx_skb_queue;
 	struct list_head tx_buf;
@@ -587,7 +587,7 @@ struct brcmf_pub {
 
 	/* Internal brcmf items */
 	bool up;		/* Driver up/down (to OS) */
-	bool txoff;		/* Transmit flow-controlled */
+	unsigned long txoff;	/* Transmit flow-controlled, bit per AC */
 	enum brcmf_bus_state busstate;
 	uint hdrlen;		/* Total BRCMF header length (proto + bus) */
 	uint maxctl;		/* Max size rxctl request from proto to bus */
@@ -691,8 +691,17 @@ extern s32 brcmf_exec_dcmd(struct net_device *dev, u32 cmd, void *arg, u32 len);
 /* Indication from bus module regarding removal/absence of dongle */
 extern void brcmf_detach(struct brcmf_pub *drvr);
 
-/* Indication from bus module to change flow-control state */
-extern void brcmf_txflowcontrol(struct brcmf_pub *drvr, int ifidx, bool on);
+/*
+ * Netdev tx queues, one per access category:
+ * AC_BK -> queue 0, AC_BE -> queue 1, AC_VI -> queue 2, AC_VO -> queue 3
+ */
+#define BRCMF_NUM_ACS		4
+
+extern const u8 brcmf_prio2ac[NUMPRIO];
+
+/* Indication from bus module to change flow-control state of an AC queue */
+extern void brcmf_txflowcontrol(struct brcmf_pub *drvr, int ifidx, int ac,
+				bool on);
 
 extern bool brcmf_c_prec_enq(struct brcmf_pub *drvr, struct pktq *q,
 			 struct sk_buff *pkt, int prec);
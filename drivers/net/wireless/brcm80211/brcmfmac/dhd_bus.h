@@ -54,4 +54,10 @@ brcmf_sdbrcm_bus_rxctl(struct brcmf_bus *bus, unsigned char *msg, uint msglen);
 
 extern void brcmf_sdbrcm_wd_timer(struct brcmf_bus *bus, uint wdtick);
 
+/* Whether the bus wants the dongle to take tx superframes (glomming) */
+extern bool brcmf_sdbrcm_bus_txglom_req(struct brcmf_bus *bus);
+
+/* Switch tx glomming on once the dongle accepted it, or back off */
+extern void brcmf_sdbrcm_bus_txglom(struct brcmf_bus *bus, bool enable);
+
 #endif				/* _BRCMF_BUS_H_ */
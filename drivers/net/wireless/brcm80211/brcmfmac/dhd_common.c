@@ -849,6 +849,17 @@ int brcmf_c_preinit_dcmds(struct brcmf_pub *drvr)
 	brcmf_proto_cdc_set_dcmd(drvr, 0, BRCMF_C_SET_VAR, iovbuf,
 				  sizeof(iovbuf));
 
+	/* let the dongle accept host superframes if the bus asks for them */
+	if (brcmf_sdbrcm_bus_txglom_req(drvr->bus)) {
+		glom = 1;
+		brcmf_c_mkiovar("bus:rxglom", (char *)&glom, 4, iovbuf,
+				sizeof(iovbuf));
+		if (brcmf_proto_cdc_set_dcmd(drvr, 0, BRCMF_C_SET_VAR, iovbuf,
+					     sizeof(iovbuf)) < 0)
+			glom = 0;
+	}
+	brcmf_sdbrcm_bus_txglom(drvr->bus, glom);
+
 	/* Setup timeout if Beacons are lost and roam is off to report
 		 link down */
 	brcmf_c_mkiovar("bcn_timeout", (char *)&bcn_timeout, 4, iovbuf,
@@ -329,13 +329,13 @@ static int brcmf_netdev_start_xmit(struct sk_buff *skb, struct net_device *ndev)
 	if (!drvr_priv->pub.up || (drvr_priv->pub.busstate == BRCMF_BUS_DOWN)) {
 		brcmf_dbg(ERROR, "xmit rejected pub.up=%d busstate=%d\n",
 			  drvr_priv->pub.up, drvr_priv->pub.busstate);
-		netif_stop_queue(ndev);
+		netif_tx_stop_all_queues(ndev);
 		return -ENODEV;
 	}
 
 	if (!drvr_priv->iflist[ifp->idx]) {
 		brcmf_dbg(ERROR, "bad ifidx %d\n", ifp->idx);
-		netif_stop_queue(ndev);
+		netif_tx_stop_all_queues(ndev);
 		return -ENODEV;
 	}
 
@@ -369,19 +369,33 @@ done:
 	return 0;
 }
 
-void brcmf_txflowcontrol(struct brcmf_pub *drvr, int ifidx, bool state)
+/* 802.1d priority to netdev tx queue, see BRCMF_NUM_ACS */
+const u8 brcmf_prio2ac[NUMPRIO] = { 1, 0, 0, 1, 2, 2, 3, 3 };
+
+static u16 brcmf_netdev_select_queue(struct net_device *ndev,
+				     struct sk_buff *skb)
+{
+	skb->priority = cfg80211_classify8021d(skb);
+
+	return brcmf_prio2ac[skb->priority & MAXPRIO];
+}
+
+void brcmf_txflowcontrol(struct brcmf_pub *drvr, int ifidx, int ac,
+			 bool state)
 {
 	struct net_device *ndev;
 	struct brcmf_info *drvr_priv = drvr->info;
 
-	brcmf_dbg(TRACE, "Enter\n");
+	brcmf_dbg(TRACE, "Enter, ac %d state %d\n", ac, state);
 
-	drvr->txoff = state;
 	ndev = drvr_priv->iflist[ifidx]->ndev;
-	if (state == ON)
-		netif_stop_queue(ndev);
-	else
-		netif_wake_queue(ndev);
+	if (state == ON) {
+		set_bit(ac, &drvr->txoff);
+		netif_stop_subqueue(ndev, ac);
+	} else {
+		clear_bit(ac, &drvr->txoff);
+		netif_wake_subqueue(ndev, ac);
+	}
 }
 
 static int brcmf_host_event(struct brcmf_info *drvr_priv, int *ifidx,
@@ -401,6 +415,28 @@ static int brcmf_host_event(struct brcmf_info *drvr_priv, int *ifidx,
 	return bcmerror;
 }
 
+static void brcmf_netif_rx_queue(struct sk_buff_head *rxq)
+{
+	struct sk_buff *skb;
+
+	if (in_interrupt()) {
+		while ((skb = __skb_dequeue(rxq)))
+			netif_rx(skb);
+		return;
+	}
+
+	/* If the receive is not processed inside an ISR, the
+	 * NET_RX_SOFTIRQ must be serviced explicitly.  Hand the whole
+	 * chain over with bottom halves disabled so that the softirq
+	 * runs once for the batch instead of once per packet, as
+	 * netif_rx_ni() would do.
+	 */
+	local_bh_disable();
+	while ((skb = __skb_dequeue(rxq)))
+		netif_rx(skb);
+	local_bh_enable();
+}
+
 void brcmf_rx_frame(struct brcmf_pub *drvr, int ifidx, struct sk_buff *skb,
 		  int numpkt)
 {
@@ -409,13 +445,15 @@ void brcmf_rx_frame(struct brcmf_pub *drvr, int ifidx, struct sk_buff *skb,
 	uint len;
 	void *data;
 	struct sk_buff *pnext, *save_pktbuf;
-	int i;
+	struct sk_buff_head rxq;
+	int i, pkt_ifidx;
 	struct brcmf_if *ifp;
 	struct brcmf_event_msg event;
 
 	brcmf_dbg(TRACE, "Enter\n");
 
 	save_pktbuf = skb;
+	__skb_queue_head_init(&rxq);
 
 	for (i = 0; skb && i < numpkt; i++, skb = pnext) {
 
@@ -437,7 +475,8 @@ void brcmf_rx_frame(struct brcmf_pub *drvr, int ifidx, struct sk_buff *skb,
 		eth = skb->data;
 		len = skb->len;
 
-		ifp = drvr_priv->iflist[ifidx];
+		pkt_ifidx = ifidx;
+		ifp = drvr_priv->iflist[pkt_ifidx];
 		if (ifp == NULL)
 			ifp = drvr_priv->iflist[0];
 
@@ -453,31 +492,30 @@ void brcmf_rx_frame(struct brcmf_pub *drvr, int ifidx, struct sk_buff *skb,
 		/* Strip header, count, deliver upward */
 		skb_pull(skb, ETH_HLEN);
 
-		/* Process special event packets and then discard them */
-		if (ntohs(skb->protocol) == ETH_P_LINK_CTL)
-			brcmf_host_event(drvr_priv, &ifidx,
+		/*
+		 * Process special event packets and then discard them. An
+		 * event may delete an interface, so the frames queued so far
+		 * have to reach the stack while their netdev still exists.
+		 */
+		if (ntohs(skb->protocol) == ETH_P_LINK_CTL) {
+			brcmf_netif_rx_queue(&rxq);
+			brcmf_host_event(drvr_priv, &pkt_ifidx,
 					  skb_mac_header(skb),
 					  &event, &data);
+		}
 
-		if (drvr_priv->iflist[ifidx]) {
-			ifp = drvr_priv->iflist[ifidx];
+		if (drvr_priv->iflist[pkt_ifidx]) {
+			ifp = drvr_priv->iflist[pkt_ifidx];
 			ifp->ndev->last_rx = jiffies;
 		}
 
 		drvr->dstats.rx_bytes += skb->len;
 		drvr->rx_packets++;	/* Local count */
 
-		if (in_interrupt())
-			netif_rx(skb);
-		else
-			/* If the receive is not processed inside an ISR,
-			 * the softirqd must be woken explicitly to service
-			 * the NET_RX_SOFTIRQ.  In 2.6 kernels, this is handled
-			 * by netif_rx_ni(), but in earlier kernels, we need
-			 * to do it manually.
-			 */
-			netif_rx_ni(skb);
+		__skb_queue_tail(&rxq, skb);
 	}
+
+	brcmf_netif_rx_queue(&rxq);
 }
 
 void brcmf_txcomplete(struct brcmf_pub *drvr, struct sk_buff *txp, bool success)
@@ -809,7 +847,7 @@ static int brcmf_netdev_stop(struct net_device *ndev)
 
 	/* Set state and stop OS transmissions */
 	drvr->up = 0;
-	netif_stop_queue(ndev);
+	netif_tx_stop_all_queues(ndev);
 
 	return 0;
 }
@@ -844,7 +882,7 @@ static int brcmf_netdev_open(struct net_device *ndev)
 				~NETIF_F_IP_CSUM;
 	}
 	/* Allow transmit calls */
-	netif_start_queue(ndev);
+	netif_tx_start_all_queues(ndev);
 	drvr_priv->pub.up = 1;
 	if (brcmf_cfg80211_up(drvr_priv->pub.config)) {
 		brcmf_dbg(ERROR, "failed to bring up cfg80211\n");
@@ -860,6 +898,7 @@ static const struct net_device_ops brcmf_netdev_ops_pri = {
 	.ndo_get_stats = brcmf_netdev_get_stats,
 	.ndo_do_ioctl = brcmf_netdev_ioctl_entry,
 	.ndo_start_xmit = brcmf_netdev_start_xmit,
+	.ndo_select_queue = brcmf_netdev_select_queue,
 	.ndo_set_mac_address = brcmf_netdev_set_mac_address,
 	.ndo_set_rx_mode = brcmf_netdev_set_multicast_list
 };
@@ -880,16 +919,17 @@ brcmf_add_if(struct brcmf_info *drvr_priv, int ifidx, char *name, u8 *mac_addr)
 	if (ifp) {
 		brcmf_dbg(ERROR, "ERROR: netdev:%s already exists, try free & unregister\n",
 			  ifp->ndev->name);
-		netif_stop_queue(ifp->ndev);
+		netif_tx_stop_all_queues(ifp->ndev);
 		unregister_netdev(ifp->ndev);
 		free_netdev(ifp->ndev);
 		drvr_priv->iflist[ifidx] = NULL;
 	}
 
 	/* Allocate netdev, including space for private structure */
-	ndev = alloc_netdev(sizeof(struct brcmf_if), name, ether_setup);
+	ndev = alloc_netdev_mq(sizeof(struct brcmf_if), name, ether_setup,
+			       BRCMF_NUM_ACS);
 	if (!ndev) {
-		brcmf_dbg(ERROR, "OOM - alloc_netdev\n");
+		brcmf_dbg(ERROR, "OOM - alloc_netdev_mq\n");
 		return -ENOMEM;
 	}
 
@@ -933,7 +973,7 @@ void brcmf_del_if(struct brcmf_info *drvr_priv, int ifidx)
 				rtnl_unlock();
 			}
 		} else {
-			netif_stop_queue(ifp->ndev);
+			netif_tx_stop_all_queues(ifp->ndev);
 		}
 
 		unregister_netdev(ifp->ndev);
@@ -96,6 +96,8 @@ struct rte_console {
 #define TXQLEN		2048	/* bulk tx queue length */
 #define TXHI		(TXQLEN - 256)	/* turn on flow control above TXHI */
 #define TXLOW		(TXHI - 256)	/* turn off flow control below TXLOW */
+#define TXHI_AC		(TXHI / BRCMF_NUM_ACS)	/* per AC queue */
+#define TXLOW_AC	(TXLOW / BRCMF_NUM_ACS)
 #define PRIOMASK	7
 
 #define TXRETRIES	2	/* # of retries for tx frames */
@@ -108,6 +110,11 @@ struct rte_console {
 
 #define BRCMF_TXMINMAX	1	/* Max tx frames if rx still pending */
 
+#define BRCMF_RXBOUND_MAX	200	/* Upper limit for adaptive rxbound */
+#define BRCMF_TXBOUND_MAX	80	/* Upper limit for adaptive txbound */
+
+#define BRCMF_RXBATCH	16	/* Max rx frames handed up in one call */
+
 #define MEMBLOCK	2048	/* Block size used for downloading
 				 of dongle image */
 #define MAX_DATA_BUF	(32 * 1024)	/* Must be large enough to hold
@@ -115,6 +122,8 @@ struct rte_console {
 
 #define BRCMF_FIRSTREAD	(1 << 6)
 
+#define BRCMF_TXGLOM_MAX	16	/* Max tx frames in one superframe */
+
 
 /* SBSDIO_DEVICE_CTL */
 
@@ -204,6 +213,12 @@ struct rte_console {
 #define SDPCM_HDRLEN	(SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN)
 #define SDPCM_RESERVE	(SDPCM_HDRLEN + BRCMF_SDALIGN)
 
+/* HW extension header, between HW and SW tag when tx glomming is on */
+#define SDPCM_HWEXT_LEN		8
+#define SDPCM_HDRLEN_TXGLOM	(SDPCM_HDRLEN + SDPCM_HWEXT_LEN)
+#define SDPCM_HWEXT_LASTFRM	(1 << 24)	/* last frame of superframe */
+#define SDPCM_HWEXT_TAILPAD_SHIFT	16
+
 /*
  * Software allocation of To SB Mailbox resources
  */
@@ -478,6 +493,10 @@ struct brcmf_bus {
 	uint txbound;		/* Tx frames to send before resched */
 	uint txminmax;
 
+	bool txglom;		/* Dongle accepts tx superframes */
+	uint txglomsize;	/* Max frames in next tx superframe */
+	struct sk_buff *txglompkt; /* Buffer for building tx superframe */
+
 	struct sk_buff *glomd;	/* Packet containing glomming descriptor */
 	struct sk_buff_head glom; /* Packet list for glommed superframe */
 	uint glomerr;		/* Glom packet read errors */
@@ -538,6 +557,9 @@ struct brcmf_bus {
 	uint rxglomfail;	/* Failed deglom attempts */
 	uint rxglomframes;	/* Number of glom frames (superframes) */
 	uint rxglompkts;	/* Number of packets from glom frames */
+	uint txglomfail;	/* Failed tx superframe writes */
+	uint txglomframes;	/* Number of tx superframes sent */
+	uint txglompkts;	/* Number of packets in tx superframes */
 	uint f2rxhdrs;		/* Number of header reads */
 	uint f2rxdata;		/* Number of frame data reads */
 	uint f2txdata;		/* Number of f2 frame writes */
@@ -579,6 +601,10 @@ static int qcount[NUMPRIO];
 static int tx_packets[NUMPRIO];
 #endif				/* BCMDBG */
 
+/* Send data frames as superframes, if the dongle supports it */
+static bool brcmf_txglom;
+module_param(brcmf_txglom, bool, 0);
+
 #define SDIO_DRIVE_STRENGTH	6	/* in milliamps */
 
 #define RETRYCHAN(chan) ((chan) == SDPCM_EVENT_CHANNEL)
@@ -1702,6 +1728,24 @@ fail:
 	return -EINVAL;
 }
 
+/* Hand a batch of received frames to the stack with sdsem released */
+static void brcmf_sdbrcm_rxdeliver(struct brcmf_bus *bus, int ifidx,
+				   struct sk_buff **head, uint *num)
+{
+	struct sk_buff *pkt = *head;
+	uint cnt = *num;
+
+	if (!cnt)
+		return;
+
+	*head = NULL;
+	*num = 0;
+
+	up(&bus->sdsem);
+	brcmf_rx_frame(bus->drvr, ifidx, pkt, cnt);
+	down(&bus->sdsem);
+}
+
 /* Return true if there may be more frames to read */
 static uint
 brcmf_sdbrcm_readframes(struct brcmf_bus *bus, uint maxframes, bool *finished)
@@ -1720,6 +1764,10 @@ brcmf_sdbrcm_readframes(struct brcmf_bus *bus, uint maxframes, bool *finished)
 	u8 *rxbuf;
 	int ifidx = 0;
 	uint rxcount = 0;	/* Total frames read */
+	struct sk_buff *rxhead = NULL;	/* Frames not yet handed up */
+	struct sk_buff *rxtail = NULL;
+	uint rxnum = 0;
+	int rxifidx = 0;
 
 	brcmf_dbg(TRACE, "Enter\n");
 
@@ -1733,6 +1781,10 @@ brcmf_sdbrcm_readframes(struct brcmf_bus *bus, uint maxframes, bool *finished)
 		/* Handle glomming separately */
 		if (bus->glomd || !skb_queue_empty(&bus->glom)) {
 			u8 cnt;
+
+			/* Keep the order of frames handed up */
+			brcmf_sdbrcm_rxdeliver(bus, rxifidx, &rxhead, &rxnum);
+
 			brcmf_dbg(GLOM, "calling rxglom: glomd %p, glom %p\n",
 				  bus->glomd, skb_peek(&bus->glom));
 			cnt = brcmf_sdbrcm_rxglom(bus, rxseq);
@@ -2073,11 +2125,21 @@ deliver:
 			continue;
 		}
 
-		/* Unlock during rx call */
-		up(&bus->sdsem);
-		brcmf_rx_frame(bus->drvr, ifidx, pkt, 1);
-		down(&bus->sdsem);
+		/* Batch up for delivery, one call per interface run */
+		if (rxnum && ifidx != rxifidx)
+			brcmf_sdbrcm_rxdeliver(bus, rxifidx, &rxhead, &rxnum);
+		if (!rxnum) {
+			rxhead = pkt;
+			rxifidx = ifidx;
+		} else {
+			rxtail->next = pkt;
+		}
+		pkt->next = NULL;
+		rxtail = pkt;
+		if (++rxnum >= BRCMF_RXBATCH)
+			brcmf_sdbrcm_rxdeliver(bus, rxifidx, &rxhead, &rxnum);
 	}
+	brcmf_sdbrcm_rxdeliver(bus, rxifidx, &rxhead, &rxnum);
 	rxcount = maxframes - rxleft;
 #ifdef BCMDBG
 	/* Message if we hit the limit */
@@ -2121,17 +2183,93 @@ brcmf_sdbrcm_wait_event_wakeup(struct brcmf_bus *bus)
 	return;
 }
 
+/* Raises a tx length to what the SDIO write should transfer */
+static uint brcmf_sdbrcm_txlen(struct brcmf_bus *bus, uint len)
+{
+	/* Raise len to next SDIO block to eliminate tail command */
+	if (bus->roundup && bus->blocksize && (len > bus->blocksize)) {
+		u16 pad = bus->blocksize - (len % bus->blocksize);
+		if ((pad <= bus->roundup) && (pad < bus->blocksize))
+			len += pad;
+	} else if (len % BRCMF_SDALIGN) {
+		len += BRCMF_SDALIGN - (len % BRCMF_SDALIGN);
+	}
+
+	/* Some controllers have trouble with odd bytes -- round to even */
+	if (len & (ALIGNMENT - 1))
+		len = roundup(len, ALIGNMENT);
+
+	return len;
+}
+
+/* Aborts a failed F2 write and terminates the frame on the dongle side */
+static void brcmf_sdbrcm_txfail(struct brcmf_bus *bus, int ret)
+{
+	int i;
+
+	brcmf_dbg(INFO, "sdio error %d, abort command and terminate frame\n",
+		  ret);
+	bus->tx_sderrs++;
+
+	brcmf_sdcard_abort(bus->sdiodev, SDIO_FUNC_2);
+	brcmf_sdcard_cfg_write(bus->sdiodev, SDIO_FUNC_1,
+			       SBSDIO_FUNC1_FRAMECTRL, SFC_WF_TERM, NULL);
+	bus->f1regdata++;
+
+	for (i = 0; i < 3; i++) {
+		u8 hi, lo;
+		hi = brcmf_sdcard_cfg_read(bus->sdiodev, SDIO_FUNC_1,
+					   SBSDIO_FUNC1_WFRAMEBCHI, NULL);
+		lo = brcmf_sdcard_cfg_read(bus->sdiodev, SDIO_FUNC_1,
+					   SBSDIO_FUNC1_WFRAMEBCLO, NULL);
+		bus->f1regdata += 2;
+		if ((hi == 0) && (lo == 0))
+			break;
+	}
+}
+
+/*
+ * Writes the HW/SW header of a tx frame. When tx glomming is on, the HW
+ * extension header goes in between; it carries the frame length without
+ * the tail padding, whether this is the last frame of the superframe and
+ * the tail padding the dongle has to strip.
+ */
+static void brcmf_sdbrcm_hdpack(struct brcmf_bus *bus, u8 *frame, u16 len,
+				uint chan, u8 seq, u8 doff, bool last,
+				u16 tail_pad)
+{
+	u32 swheader;
+
+	/* Hardware tag: 2 byte len followed by 2 byte ~len check (all LE) */
+	*(__le16 *) frame = cpu_to_le16(len);
+	*(((__le16 *) frame) + 1) = cpu_to_le16(~len);
+	frame += SDPCM_FRAMETAG_LEN;
+
+	if (bus->txglom) {
+		put_unaligned_le32((len - tail_pad) |
+				   (last ? SDPCM_HWEXT_LASTFRM : 0), frame);
+		put_unaligned_le32((u32)tail_pad << SDPCM_HWEXT_TAILPAD_SHIFT,
+				   frame + sizeof(u32));
+		frame += SDPCM_HWEXT_LEN;
+	}
+
+	/* Software tag: channel, sequence number, data offset */
+	swheader = ((chan << SDPCM_CHANNEL_SHIFT) & SDPCM_CHANNEL_MASK) | seq |
+		   ((doff << SDPCM_DOFFSET_SHIFT) & SDPCM_DOFFSET_MASK);
+	put_unaligned_le32(swheader, frame);
+	put_unaligned_le32(0, frame + sizeof(swheader));
+}
+
 /* Writes a HW/SW header into the packet and sends it. */
 /* Assumes: (a) header space already there, (b) caller holds lock */
+/* Not used for data frames while tx glomming is on */
 static int brcmf_sdbrcm_txpkt(struct brcmf_bus *bus, struct sk_buff *pkt,
 			      uint chan, bool free_pkt)
 {
 	int ret;
 	u8 *frame;
 	u16 len, pad = 0;
-	u32 swheader;
 	struct sk_buff *new;
-	int i;
 
 	brcmf_dbg(TRACE, "Enter\n");
 
@@ -2171,19 +2309,9 @@ static int brcmf_sdbrcm_txpkt(struct brcmf_bus *bus, struct sk_buff *pkt,
 	}
 	/* precondition: pad < BRCMF_SDALIGN */
 
-	/* Hardware tag: 2 byte len followed by 2 byte ~len check (all LE) */
 	len = (u16) (pkt->len);
-	*(__le16 *) frame = cpu_to_le16(len);
-	*(((__le16 *) frame) + 1) = cpu_to_le16(~len);
-
-	/* Software tag: channel, sequence number, data offset */
-	swheader =
-	    ((chan << SDPCM_CHANNEL_SHIFT) & SDPCM_CHANNEL_MASK) | bus->tx_seq |
-	    (((pad +
-	       SDPCM_HDRLEN) << SDPCM_DOFFSET_SHIFT) & SDPCM_DOFFSET_MASK);
-
-	put_unaligned_le32(swheader, frame + SDPCM_FRAMETAG_LEN);
-	put_unaligned_le32(0, frame + SDPCM_FRAMETAG_LEN + sizeof(swheader));
+	brcmf_sdbrcm_hdpack(bus, frame, len, chan, bus->tx_seq,
+			    pad + SDPCM_HDRLEN, true, 0);
 
 #ifdef BCMDBG
 	tx_packets[pkt->priority]++;
@@ -2199,52 +2327,17 @@ static int brcmf_sdbrcm_txpkt(struct brcmf_bus *bus, struct sk_buff *pkt,
 	}
 #endif
 
-	/* Raise len to next SDIO block to eliminate tail command */
-	if (bus->roundup && bus->blocksize && (len > bus->blocksize)) {
-		u16 pad = bus->blocksize - (len % bus->blocksize);
-		if ((pad <= bus->roundup) && (pad < bus->blocksize))
-				len += pad;
-	} else if (len % BRCMF_SDALIGN) {
-		len += BRCMF_SDALIGN - (len % BRCMF_SDALIGN);
-	}
-
-	/* Some controllers have trouble with odd bytes -- round to even */
-	if (len & (ALIGNMENT - 1))
-			len = roundup(len, ALIGNMENT);
+	len = brcmf_sdbrcm_txlen(bus, len);
 
 	ret = brcmf_sdbrcm_send_buf(bus, bus->sdiodev->sbwad,
 				    SDIO_FUNC_2, F2SYNC, frame,
 				    len, pkt);
 	bus->f2txdata++;
 
-	if (ret < 0) {
-		/* On failure, abort the command and terminate the frame */
-		brcmf_dbg(INFO, "sdio error %d, abort command and terminate frame\n",
-			  ret);
-		bus->tx_sderrs++;
-
-		brcmf_sdcard_abort(bus->sdiodev, SDIO_FUNC_2);
-		brcmf_sdcard_cfg_write(bus->sdiodev, SDIO_FUNC_1,
-				 SBSDIO_FUNC1_FRAMECTRL, SFC_WF_TERM,
-				 NULL);
-		bus->f1regdata++;
-
-		for (i = 0; i < 3; i++) {
-			u8 hi, lo;
-			hi = brcmf_sdcard_cfg_read(bus->sdiodev,
-					     SDIO_FUNC_1,
-					     SBSDIO_FUNC1_WFRAMEBCHI,
-					     NULL);
-			lo = brcmf_sdcard_cfg_read(bus->sdiodev,
-					     SDIO_FUNC_1,
-					     SBSDIO_FUNC1_WFRAMEBCLO,
-					     NULL);
-			bus->f1regdata += 2;
-			if ((hi == 0) && (lo == 0))
-				break;
-		}
+	/* On failure, abort the command and terminate the frame */
+	if (ret < 0)
+		brcmf_sdbrcm_txfail(bus, ret);
 
-	}
 	if (ret == 0)
 		bus->tx_seq = (bus->tx_seq + 1) % SDPCM_SEQUENCE_WRAP;
 
@@ -2261,13 +2354,134 @@ done:
 	return ret;
 }
 
+/*
+ * Packs up to maxframes queued data frames into one superframe and sends
+ * it with a single F2 write. Each frame is copied into the superframe
+ * buffer behind its own HW tag, HW extension header and SW header, padded
+ * to ALIGNMENT, and takes its own sequence number. The number of frames
+ * per superframe adapts: it is halved on a failed write and grows back by
+ * one with every good one. Returns the number of frames dequeued.
+ */
+static uint brcmf_sdbrcm_txglom(struct brcmf_bus *bus, uint maxframes)
+{
+	struct sk_buff_head pktq;
+	struct sk_buff *pkt, *glom = bus->txglompkt;
+	u8 tx_prec_map = ~bus->flowcontrol;
+	u8 *frame;
+	uint num, sublen, datalen, total = 0;
+	u16 tail_pad;
+	u8 seq;
+	int ret, prec_out;
+
+	/* Every frame takes a sequence number from the dongle window */
+	num = min_t(uint, maxframes, bus->txglomsize);
+	num = min_t(uint, num, (u8)(bus->tx_max - bus->tx_seq));
+
+	__skb_queue_head_init(&pktq);
+
+	spin_lock_bh(&bus->txqlock);
+	while (skb_queue_len(&pktq) < num) {
+		pkt = brcmu_pktq_mdeq(&bus->txq, tx_prec_map, &prec_out);
+		if (pkt == NULL)
+			break;
+		sublen = roundup(pkt->len - SDPCM_HDRLEN + SDPCM_HDRLEN_TXGLOM,
+				 ALIGNMENT);
+		if (total + sublen > MAX_DATA_BUF - max_roundup) {
+			brcmu_pktq_penq_head(&bus->txq, prec_out, pkt);
+			break;
+		}
+		total += sublen;
+		__skb_queue_tail(&pktq, pkt);
+	}
+	spin_unlock_bh(&bus->txqlock);
+
+	num = skb_queue_len(&pktq);
+	if (!num)
+		return 0;
+
+	/* Build the superframe */
+	total = 0;
+	seq = bus->tx_seq;
+	skb_queue_walk(&pktq, pkt) {
+		frame = glom->data + total;
+		datalen = pkt->len - SDPCM_HDRLEN;
+		sublen = SDPCM_HDRLEN_TXGLOM + datalen;
+
+		memcpy(frame + SDPCM_HDRLEN_TXGLOM, pkt->data + SDPCM_HDRLEN,
+		       datalen);
+
+		/* The last frame pads the superframe for the SDIO write */
+		if (skb_queue_is_last(&pktq, pkt))
+			tail_pad = brcmf_sdbrcm_txlen(bus, total + sublen) -
+				   (total + sublen);
+		else
+			tail_pad = roundup(sublen, ALIGNMENT) - sublen;
+
+		brcmf_sdbrcm_hdpack(bus, frame, sublen + tail_pad,
+				    SDPCM_DATA_CHANNEL, seq, SDPCM_HDRLEN_TXGLOM,
+				    skb_queue_is_last(&pktq, pkt), tail_pad);
+
+		total += sublen + tail_pad;
+		seq = (seq + 1) % SDPCM_SEQUENCE_WRAP;
+	}
+	skb_put(glom, total);
+
+	ret = brcmf_sdbrcm_send_buf(bus, bus->sdiodev->sbwad, SDIO_FUNC_2,
+				    F2SYNC, glom->data, total, glom);
+	bus->f2txdata++;
+
+	__skb_trim(glom, 0);
+
+	if (ret < 0) {
+		/* On failure, abort the command and terminate the frame */
+		brcmf_sdbrcm_txfail(bus, ret);
+		bus->txglomfail++;
+		bus->txglomsize = max_t(uint, bus->txglomsize / 2, 1);
+	} else {
+		bus->tx_seq = seq;
+		bus->txglomframes++;
+		bus->txglompkts += num;
+		if (bus->txglomsize < BRCMF_TXGLOM_MAX)
+			bus->txglomsize++;
+	}
+
+	while ((pkt = __skb_dequeue(&pktq))) {
+		datalen = pkt->len - SDPCM_HDRLEN;
+		if (ret)
+			bus->drvr->tx_errors++;
+		else
+			bus->drvr->dstats.tx_bytes += datalen;
+
+		/* restore pkt buffer pointer before calling tx complete */
+		skb_pull(pkt, SDPCM_HDRLEN);
+		up(&bus->sdsem);
+		brcmf_txcomplete(bus->drvr, pkt, ret != 0);
+		down(&bus->sdsem);
+		brcmu_pkt_buf_free_skb(pkt);
+	}
+
+	return num;
+}
+
+/* Number of frames queued on the bus for an access category */
+static uint brcmf_sdbrcm_ac_qlen(struct brcmf_bus *bus, int ac)
+{
+	uint prio, len = 0;
+
+	for (prio = 0; prio < NUMPRIO; prio++)
+		if (brcmf_prio2ac[prio] == ac)
+			len += pktq_plen(&bus->txq, prio2prec(prio));
+
+	return len;
+}
+
 static uint brcmf_sdbrcm_sendfromq(struct brcmf_bus *bus, uint maxframes)
 {
 	struct sk_buff *pkt;
 	u32 intstatus = 0;
 	uint retries = 0;
 	int ret = 0, prec_out;
-	uint cnt = 0;
+	uint cnt = 0, num;
 	uint datalen;
 	u8 tx_prec_map;
 
@@ -2278,21 +2492,30 @@ static uint brcmf_sdbrcm_sendfromq(struct brcmf_bus *bus, uint maxframes)
 	tx_prec_map = ~bus->flowcontrol;
 
 	/* Send frames until the limit or some other event */
-	for (cnt = 0; (cnt < maxframes) && data_ok(bus); cnt++) {
-		spin_lock_bh(&bus->txqlock);
-		pkt = brcmu_pktq_mdeq(&bus->txq, tx_prec_map, &prec_out);
-		if (pkt == NULL) {
+	for (cnt = 0; (cnt < maxframes) && data_ok(bus); cnt += num) {
+		if (bus->txglom) {
+			num = brcmf_sdbrcm_txglom(bus, maxframes - cnt);
+			if (!num)
+				break;
+		} else {
+			spin_lock_bh(&bus->txqlock);
+			pkt = brcmu_pktq_mdeq(&bus->txq, tx_prec_map,
+					      &prec_out);
+			if (pkt == NULL) {
+				spin_unlock_bh(&bus->txqlock);
+				break;
+			}
 			spin_unlock_bh(&bus->txqlock);
-			break;
-		}
-		spin_unlock_bh(&bus->txqlock);
-		datalen = pkt->len - SDPCM_HDRLEN;
+			datalen = pkt->len - SDPCM_HDRLEN;
+			num = 1;
 
-		ret = brcmf_sdbrcm_txpkt(bus, pkt, SDPCM_DATA_CHANNEL, true);
-		if (ret)
-			bus->drvr->tx_errors++;
-		else
-			bus->drvr->dstats.tx_bytes += datalen;
+			ret = brcmf_sdbrcm_txpkt(bus, pkt, SDPCM_DATA_CHANNEL,
+						 true);
+			if (ret)
+				bus->drvr->tx_errors++;
+			else
+				bus->drvr->dstats.tx_bytes += datalen;
+		}
 
 		/* In poll mode, need to check for other events */
 		if (!bus->intr && cnt) {
@@ -2308,14 +2531,35 @@ static uint brcmf_sdbrcm_sendfromq(struct brcmf_bus *bus, uint maxframes)
 		}
 	}
 
-	/* Deflow-control stack if needed */
-	if (drvr->up && (drvr->busstate == BRCMF_BUS_DATA) &&
-	    drvr->txoff && (pktq_len(&bus->txq) < TXLOW))
-		brcmf_txflowcontrol(drvr, 0, OFF);
+	/* Deflow-control the AC queues that drained */
+	if (drvr->up && (drvr->busstate == BRCMF_BUS_DATA) && drvr->txoff) {
+		int ac;
+
+		for (ac = 0; ac < BRCMF_NUM_ACS; ac++)
+			if (test_bit(ac, &drvr->txoff) &&
+			    brcmf_sdbrcm_ac_qlen(bus, ac) < TXLOW_AC)
+				brcmf_txflowcontrol(drvr, 0, ac, OFF);
+	}
 
 	return cnt;
 }
 
+/*
+ * Adapt a per-DPC frame budget. A budget that ran out while the other
+ * direction had nothing waiting doubles to cut down on reschedules; one
+ * that ran out while the other direction was waiting halves back toward
+ * its default so that direction is served sooner.
+ */
+static uint brcmf_sdbrcm_adapt_bound(uint bound, uint def, uint limit,
+				     bool exhausted, bool contended)
+{
+	if (!exhausted)
+		return bound;
+	if (contended)
+		return max(bound / 2, def);
+	return min(bound * 2, limit);
+}
+
 static bool brcmf_sdbrcm_dpc(struct brcmf_bus *bus)
 {
 	u32 intstatus, newstatus = 0;
@@ -2466,6 +2710,10 @@ static bool brcmf_sdbrcm_dpc(struct brcmf_bus *bus)
 		framecnt = brcmf_sdbrcm_readframes(bus, rxlimit, &rxdone);
 		if (rxdone || bus->rxskip)
 			intstatus &= ~I_HMB_FRAME_IND;
+		bus->rxbound = brcmf_sdbrcm_adapt_bound(bus->rxbound,
+				BRCMF_RXBOUND, BRCMF_RXBOUND_MAX,
+				!rxdone && framecnt >= rxlimit,
+				brcmu_pktq_mlen(&bus->txq, ~bus->flowcontrol));
 		rxlimit -= min(framecnt, rxlimit);
 	}
 
@@ -2522,8 +2770,14 @@ clkwait:
 	else if ((bus->clkstate == CLK_AVAIL) && !bus->fcstate &&
 		 brcmu_pktq_mlen(&bus->txq, ~bus->flowcontrol) && txlimit
 		 && data_ok(bus)) {
-		framecnt = rxdone ? txlimit : min(txlimit, bus->txminmax);
-		framecnt = brcmf_sdbrcm_sendfromq(bus, framecnt);
+		uint txcnt = rxdone ? txlimit : min(txlimit, bus->txminmax);
+
+		framecnt = brcmf_sdbrcm_sendfromq(bus, txcnt);
+		bus->txbound = brcmf_sdbrcm_adapt_bound(bus->txbound,
+				BRCMF_TXBOUND, BRCMF_TXBOUND_MAX,
+				framecnt >= txcnt &&
+				brcmu_pktq_mlen(&bus->txq, ~bus->flowcontrol),
+				!rxdone);
 		txlimit -= framecnt;
 	}
 
@@ -2591,6 +2845,7 @@ int brcmf_sdbrcm_bus_txdata(struct brcmf_bus *bus, struct sk_buff *pkt)
 {
 	int ret = -EBADE;
 	uint datalen, prec;
+	int ac;
 
 	brcmf_dbg(TRACE, "Enter\n");
 
@@ -2601,6 +2856,7 @@ int brcmf_sdbrcm_bus_txdata(struct brcmf_bus *bus, struct sk_buff *pkt)
 	/* precondition: IS_ALIGNED((unsigned long)(pkt->data), 2) */
 
 	prec = prio2prec((pkt->priority & PRIOMASK));
+	ac = brcmf_prio2ac[pkt->priority & PRIOMASK];
 
 	/* Check for existing queue, current flow-control,
 			 pending event, or pending clock */
@@ -2620,8 +2876,10 @@ int brcmf_sdbrcm_bus_txdata(struct brcmf_bus *bus, struct sk_buff *pkt)
 	}
 	spin_unlock_bh(&bus->txqlock);
 
-	if (pktq_len(&bus->txq) >= TXHI)
-		brcmf_txflowcontrol(bus->drvr, 0, ON);
+	/* Only the AC that filled up is flow-controlled */
+	if (!test_bit(ac, &bus->drvr->txoff) &&
+	    brcmf_sdbrcm_ac_qlen(bus, ac) >= TXHI_AC)
+		brcmf_txflowcontrol(bus->drvr, 0, ac, ON);
 
 #ifdef BCMDBG
 	if (pktq_plen(&bus->txq, prec) > qcount[prec])
@@ -2823,16 +3081,20 @@ brcmf_sdbrcm_bus_txctl(struct brcmf_bus *bus, unsigned char *msg, uint msglen)
 {
 	u8 *frame;
 	u16 len;
-	u32 swheader;
 	uint retries = 0;
+	uint hdrlen;
 	u8 doff = 0;
 	int ret = -1;
 
 	brcmf_dbg(TRACE, "Enter\n");
 
+	/* Need to lock here to protect txseq and SDIO tx calls */
+	down(&bus->sdsem);
+
 	/* Back the pointer to make a room for bus header */
-	frame = msg - SDPCM_HDRLEN;
-	len = (msglen += SDPCM_HDRLEN);
+	hdrlen = bus->txglom ? SDPCM_HDRLEN_TXGLOM : SDPCM_HDRLEN;
+	frame = msg - hdrlen;
+	len = (msglen += hdrlen);
 
 	/* Add alignment padding (optional for ctl frames) */
 	doff = ((unsigned long)frame % BRCMF_SDALIGN);
@@ -2840,46 +3102,23 @@ brcmf_sdbrcm_bus_txctl(struct brcmf_bus *bus, unsigned char *msg, uint msglen)
 		frame -= doff;
 		len += doff;
 		msglen += doff;
-		memset(frame, 0, doff + SDPCM_HDRLEN);
+		memset(frame, 0, doff + hdrlen);
 	}
 	/* precondition: doff < BRCMF_SDALIGN */
-	doff += SDPCM_HDRLEN;
+	doff += hdrlen;
 
 	/* Round send length to next SDIO block */
-	if (bus->roundup && bus->blocksize && (len > bus->blocksize)) {
-		u16 pad = bus->blocksize - (len % bus->blocksize);
-		if ((pad <= bus->roundup) && (pad < bus->blocksize))
-			len += pad;
-	} else if (len % BRCMF_SDALIGN) {
-		len += BRCMF_SDALIGN - (len % BRCMF_SDALIGN);
-	}
-
-	/* Satisfy length-alignment requirements */
-	if (len & (ALIGNMENT - 1))
-		len = roundup(len, ALIGNMENT);
+	len = brcmf_sdbrcm_txlen(bus, len);
 
 	/* precondition: IS_ALIGNED((unsigned long)frame, 2) */
 
-	/* Need to lock here to protect txseq and SDIO tx calls */
-	down(&bus->sdsem);
-
 	bus_wake(bus);
 
 	/* Make sure backplane clock is on */
 	brcmf_sdbrcm_clkctl(bus, CLK_AVAIL, false);
 
-	/* Hardware tag: 2 byte len followed by 2 byte ~len check (all LE) */
-	*(__le16 *) frame = cpu_to_le16((u16) msglen);
-	*(((__le16 *) frame) + 1) = cpu_to_le16(~msglen);
-
-	/* Software tag: channel, sequence number, data offset */
-	swheader =
-	    ((SDPCM_CONTROL_CHANNEL << SDPCM_CHANNEL_SHIFT) &
-	     SDPCM_CHANNEL_MASK)
-	    | bus->tx_seq | ((doff << SDPCM_DOFFSET_SHIFT) &
-			     SDPCM_DOFFSET_MASK);
-	put_unaligned_le32(swheader, frame + SDPCM_FRAMETAG_LEN);
-	put_unaligned_le32(0, frame + SDPCM_FRAMETAG_LEN + sizeof(swheader));
+	brcmf_sdbrcm_hdpack(bus, frame, (u16) msglen, SDPCM_CONTROL_CHANNEL,
+			    bus->tx_seq, doff, true, 0);
 
 	if (!data_ok(bus)) {
 		brcmf_dbg(INFO, "No bus credit bus->tx_max %d, bus->tx_seq %d\n",
@@ -3661,6 +3900,10 @@ static void brcmf_sdbrcm_release_malloc(struct brcmf_bus *bus)
 
 	kfree(bus->databuf);
 	bus->databuf = NULL;
+
+	if (bus->txglompkt)
+		brcmu_pkt_buf_free_skb(bus->txglompkt);
+	bus->txglompkt = NULL;
 }
 
 static bool brcmf_sdbrcm_probe_malloc(struct brcmf_bus *bus)
@@ -3692,6 +3935,16 @@ static bool brcmf_sdbrcm_probe_malloc(struct brcmf_bus *bus)
 	else
 		bus->dataptr = bus->databuf;
 
+	/* Allocate buffer to build tx superframes */
+	if (brcmf_txglom) {
+		bus->txglompkt =
+			brcmu_pkt_buf_get_skb(MAX_DATA_BUF + BRCMF_SDALIGN);
+		if (bus->txglompkt)
+			pkt_align(bus->txglompkt, 0, BRCMF_SDALIGN);
+		else
+			brcmf_dbg(ERROR, "no tx superframe buffer, glomming off\n");
+	}
+
 	return true;
 
 fail:
@@ -3921,6 +4174,7 @@ void *brcmf_sdbrcm_probe(u16 bus_no, u16 slot, u16 func, uint bustype,
 	bus->txbound = BRCMF_TXBOUND;
 	bus->rxbound = BRCMF_RXBOUND;
 	bus->txminmax = BRCMF_TXMINMAX;
+	bus->txglomsize = BRCMF_TXGLOM_MAX;
 	bus->tx_seq = SDPCM_SEQUENCE_WRAP - 1;
 	bus->usebufpool = false;	/* Use bufpool if allocated,
 					 else use locally malloced rxbuf */
@@ -4030,6 +4284,21 @@ struct device *brcmf_bus_get_device(struct brcmf_bus *bus)
 	return &bus->sdiodev->func[2]->dev;
 }
 
+bool brcmf_sdbrcm_bus_txglom_req(struct brcmf_bus *bus)
+{
+	return bus->txglompkt != NULL;
+}
+
+void brcmf_sdbrcm_bus_txglom(struct brcmf_bus *bus, bool enable)
+{
+	down(&bus->sdsem);
+	bus->txglom = enable && bus->txglompkt;
+	bus->txglomsize = BRCMF_TXGLOM_MAX;
+	up(&bus->sdsem);
+
+	brcmf_dbg(INFO, "tx glomming %s\n", bus->txglom ? "on" : "off");
+}
+
 void
 brcmf_sdbrcm_wd_timer(struct brcmf_bus *bus, uint wdtick)
 {
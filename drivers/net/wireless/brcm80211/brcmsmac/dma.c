@@ -239,6 +239,7 @@ struct dma_info {
 	u16 ntxd;		/* # tx descriptors tunable */
 	u16 txin;		/* index of next descriptor to reclaim */
 	u16 txout;		/* index of next descriptor to post */
+	u16 txend;		/* transmitted up to here, as last read from hw */
 	/* pointer to parallel array of pointers to packets */
 	struct sk_buff **txp;
 	/* Aligned physical address of descriptor ring */
@@ -264,6 +265,8 @@ struct dma_info {
 	u16 rxdalign;	/* #bytes added to alloc'd mem to align rxd */
 	u32 rxdalloc;	/* #bytes allocated for the ring */
 	u32 rcvptrbase;	/* Base for ptr reg when using unaligned descriptors */
+	/* tossed rx buffers kept for the next dma_rxfill() */
+	struct sk_buff_head rxfree;
 
 	/* tunables */
 	unsigned int rxbufsize;	/* rx buffer size in bytes, not including
@@ -570,7 +573,7 @@ struct dma_pub *dma_attach(char *name, struct si_pub *sih,
 		return NULL;
 
 	di->msg_level = msg_level ? msg_level : &dma_msg_level;
-
+	__skb_queue_head_init(&di->rxfree);
 
 	di->dma64 = ((ai_core_sflags(sih, 0, 0) & SISF_DMA64) == SISF_DMA64);
 
@@ -761,6 +764,8 @@ void dma_detach(struct dma_pub *pub)
 	kfree(di->txp);
 	kfree(di->rxp);
 
+	__skb_queue_purge(&di->rxfree);
+
 	/* free our private info structure */
 	kfree(di);
 
@@ -964,7 +969,7 @@ int dma_rx(struct dma_pub *pub, struct sk_buff_head *skb_list)
 				  di->name, len);
 			skb_queue_walk_safe(&dma_frames, p, next) {
 				skb_unlink(p, &dma_frames);
-				brcmu_pkt_buf_free_skb(p);
+				dma_rxrecycle(pub, p);
 			}
 			di->dma.rxgiants++;
 			pktcnt = 1;
@@ -1028,7 +1033,11 @@ bool dma_rxfill(struct dma_pub *pub)
 		 * the di->rxbufsize doesn't include the extra headroom,
 		 * we need to add it to the size to be allocated
 		 */
-		p = brcmu_pkt_buf_get_skb(di->rxbufsize + extra_offset);
+		p = __skb_dequeue(&di->rxfree);
+		if (p)
+			skb_put(p, di->rxbufsize + extra_offset);
+		else
+			p = brcmu_pkt_buf_get_skb(di->rxbufsize + extra_offset);
 
 		if (p == NULL) {
 			DMA_ERROR("%s: out of rxbufs\n", di->name);
@@ -1073,6 +1082,26 @@ bool dma_rxfill(struct dma_pub *pub)
 	return ring_empty;
 }
 
+/*
+ * Give a received buffer that will not be passed up back to the rx ring.
+ * It is reset and posted again by the next dma_rxfill() instead of being
+ * freed and a new one allocated.
+ */
+void dma_rxrecycle(struct dma_pub *pub, struct sk_buff *p)
+{
+	struct dma_info *di = (struct dma_info *)pub;
+	uint size = di->rxbufsize;
+
+	if (di->rxbufsize > BCMEXTRAHDROOM)
+		size += di->rxextrahdrroom;
+
+	if (skb_queue_len(&di->rxfree) < di->nrxpost &&
+	    skb_recycle_check(p, size))
+		__skb_queue_tail(&di->rxfree, p);
+	else
+		brcmu_pkt_buf_free_skb(p);
+}
+
 void dma_rxreclaim(struct dma_pub *pub)
 {
 	struct dma_info *di = (struct dma_info *)pub;
@@ -1114,7 +1143,7 @@ void dma_txinit(struct dma_pub *pub)
 	if (di->ntxd == 0)
 		return;
 
-	di->txin = di->txout = 0;
+	di->txin = di->txout = di->txend = 0;
 	di->dma.txavail = di->ntxd - 1;
 
 	/* clear tx descriptor ring */
@@ -1234,14 +1263,11 @@ bool dma_rxreset(struct dma_pub *pub)
 }
 
 /*
- * !! tx entry routine
- * WARNING: call must check the return value for error.
- *   the error(toss frames) could be fatal and cause many subsequent hard
- *   to debug problems
+ * Fill the descriptors for one packet chain without telling the chip.
+ * The packet is tossed if the ring is out of descriptors.
  */
-int dma_txfast(struct dma_pub *pub, struct sk_buff *p0, bool commit)
+static int dma_txenq(struct dma_info *di, struct sk_buff *p0)
 {
-	struct dma_info *di = (struct dma_info *)pub;
 	struct sk_buff *p, *next;
 	unsigned char *data;
 	uint len;
@@ -1249,8 +1275,6 @@ int dma_txfast(struct dma_pub *pub, struct sk_buff *p0, bool commit)
 	u32 flags = 0;
 	dma_addr_t pa;
 
-	DMA_TRACE("%s:\n", di->name);
-
 	txout = di->txout;
 
 	/*
@@ -1302,24 +1326,74 @@ int dma_txfast(struct dma_pub *pub, struct sk_buff *p0, bool commit)
 	/* bump the tx descriptor index */
 	di->txout = txout;
 
-	/* kick the chip */
-	if (commit)
-		W_REG(&di->d64txregs->ptr,
-		      di->xmtptrbase + I2B(txout, struct dma64desc));
-
-	/* tx flow control */
-	di->dma.txavail = di->ntxd - ntxdactive(di, di->txin, di->txout) - 1;
-
 	return 0;
 
  outoftxd:
 	DMA_ERROR("%s: out of txds !!!\n", di->name);
 	brcmu_pkt_buf_free_skb(p0);
-	di->dma.txavail = 0;
 	di->dma.txnobuf++;
 	return -1;
 }
 
+/* kick the chip: make everything up to txout visible as posted */
+static void dma_txcommit(struct dma_info *di)
+{
+	W_REG(&di->d64txregs->ptr,
+	      di->xmtptrbase + I2B(di->txout, struct dma64desc));
+}
+
+/*
+ * !! tx entry routine
+ * WARNING: call must check the return value for error.
+ *   the error(toss frames) could be fatal and cause many subsequent hard
+ *   to debug problems
+ */
+int dma_txfast(struct dma_pub *pub, struct sk_buff *p0, bool commit)
+{
+	struct dma_info *di = (struct dma_info *)pub;
+	int ret;
+
+	DMA_TRACE("%s:\n", di->name);
+
+	ret = dma_txenq(di, p0);
+	if (commit)
+		dma_txcommit(di);
+
+	/* tx flow control */
+	di->dma.txavail = di->ntxd - ntxdactive(di, di->txin, di->txout) - 1;
+	if (ret)
+		di->dma.txavail = 0;
+
+	return ret;
+}
+
+/*
+ * Post a batch of packets, e.g. all MPDUs of an A-MPDU, and kick the
+ * chip once for the whole batch. Returns the number of packets that had
+ * to be tossed for lack of descriptors.
+ */
+int dma_txfast_batch(struct dma_pub *pub, struct sk_buff **pkts, int count)
+{
+	struct dma_info *di = (struct dma_info *)pub;
+	int i, tossed = 0;
+
+	DMA_TRACE("%s: %d pkts\n", di->name, count);
+
+	for (i = 0; i < count; i++)
+		if (dma_txenq(di, pkts[i]))
+			tossed++;
+
+	if (tossed < count)
+		dma_txcommit(di);
+
+	/* tx flow control */
+	di->dma.txavail = di->ntxd - ntxdactive(di, di->txin, di->txout) - 1;
+	if (tossed)
+		di->dma.txavail = 0;
+
+	return tossed;
+}
+
 /*
  * Reclaim next completed txd (txds if using chained buffers) in the range
  * specified and return associated packet.
@@ -1329,6 +1403,10 @@ int dma_txfast(struct dma_pub *pub, struct sk_buff *p0, bool commit)
  * transferred by the DMA as noted by the hardware "ActiveDescr" pointer.
  * If range is DMA_RANGE_ALL, reclaim all txd(s) posted to the ring and
  * return associated packet regardless of the value of hardware pointers.
+ *
+ * For DMA_RANGE_TRANSMITTED the "CurrDescr" pointer is only read again once
+ * everything up to its last value has been reclaimed, so reclaiming a batch
+ * of packets, e.g. a whole A-MPDU, costs a single register read.
  */
 struct sk_buff *dma_getnexttxp(struct dma_pub *pub, enum txd_range range)
 {
@@ -1351,6 +1429,8 @@ struct sk_buff *dma_getnexttxp(struct dma_pub *pub, enum txd_range range)
 	start = di->txin;
 	if (range == DMA_RANGE_ALL)
 		end = di->txout;
+	else if (range == DMA_RANGE_TRANSMITTED && start != di->txend)
+		end = di->txend;
 	else {
 		struct dma64regs __iomem *dregs = di->d64txregs;
 
@@ -1374,6 +1454,9 @@ struct sk_buff *dma_getnexttxp(struct dma_pub *pub, enum txd_range range)
 	if ((start == 0) && (end > di->txout))
 		goto bogus;
 
+	if (range == DMA_RANGE_TRANSMITTED)
+		di->txend = end;
+
 	for (i = start; i != end && !txp; i = nexttxd(di, i)) {
 		dma_addr_t pa;
 		uint size;
@@ -1395,6 +1478,10 @@ struct sk_buff *dma_getnexttxp(struct dma_pub *pub, enum txd_range range)
 
 	di->txin = i;
 
+	/* other ranges may have moved txin past the cached pointer */
+	if (range != DMA_RANGE_TRANSMITTED)
+		di->txend = di->txin;
+
 	/* tx flow control */
 	di->dma.txavail = di->ntxd - ntxdactive(di, di->txin, di->txout) - 1;
 
@@ -83,10 +83,12 @@ extern struct dma_pub *dma_attach(char *name, struct si_pub *sih,
 void dma_rxinit(struct dma_pub *pub);
 int dma_rx(struct dma_pub *pub, struct sk_buff_head *skb_list);
 bool dma_rxfill(struct dma_pub *pub);
+void dma_rxrecycle(struct dma_pub *pub, struct sk_buff *p);
 bool dma_rxreset(struct dma_pub *pub);
 bool dma_txreset(struct dma_pub *pub);
 void dma_txinit(struct dma_pub *pub);
 int dma_txfast(struct dma_pub *pub, struct sk_buff *p0, bool commit);
+int dma_txfast_batch(struct dma_pub *pub, struct sk_buff **pkts, int count);
 void dma_txsuspend(struct dma_pub *pub);
 bool dma_txsuspended(struct dma_pub *pub);
 void dma_txresume(struct dma_pub *pub);
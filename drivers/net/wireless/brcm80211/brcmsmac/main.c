@@ -7407,6 +7407,23 @@ brcms_c_txfifo(struct brcms_c_info *wlc, uint fifo, struct sk_buff *p,
 		wiphy_err(wlc->wiphy, "txfifo: fatal, toss frames !!!\n");
 }
 
+/*
+ * Post a batch of frames to a fifo in one go, kicking the DMA once for
+ * all of them. Not for the BCMC fifo, whose frame ids go to the ucode
+ * one by one through brcms_c_txfifo().
+ */
+void
+brcms_c_txfifo_batch(struct brcms_c_info *wlc, uint fifo,
+		     struct sk_buff **pkts, int count, s8 txpktpend)
+{
+	wlc->core->txpktpend[fifo] += txpktpend;
+	BCMMSG(wlc->wiphy, "pktpend inc %d to %d\n",
+	       txpktpend, wlc->core->txpktpend[fifo]);
+
+	if (dma_txfast_batch(wlc->hw->di[fifo], pkts, count))
+		wiphy_err(wlc->wiphy, "txfifo: fatal, toss frames !!!\n");
+}
+
 u32
 brcms_c_rspec_to_rts_rspec(struct brcms_c_info *wlc, u32 rspec,
 			   bool use_rspec, u16 mimo_ctlchbw)
@@ -8097,7 +8114,7 @@ static void brcms_c_recv(struct brcms_c_info *wlc, struct sk_buff *p)
 	return;
 
  toss:
-	brcmu_pkt_buf_free_skb(p);
+	dma_rxrecycle(wlc->hw->di[RX_FIFO], p);
 }
 
 /* Process received frames */
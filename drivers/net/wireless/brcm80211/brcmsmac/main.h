@@ -643,6 +643,9 @@ struct brcms_bss_cfg {
 extern void brcms_c_txfifo(struct brcms_c_info *wlc, uint fifo,
 			   struct sk_buff *p,
 			   bool commit, s8 txpktpend);
+extern void brcms_c_txfifo_batch(struct brcms_c_info *wlc, uint fifo,
+				 struct sk_buff **pkts, int count,
+				 s8 txpktpend);
 extern void brcms_c_txfifo_complete(struct brcms_c_info *wlc, uint fifo,
 				    s8 txpktpend);
 extern void brcms_c_txq_enq(struct brcms_c_info *wlc, struct scb *scb,
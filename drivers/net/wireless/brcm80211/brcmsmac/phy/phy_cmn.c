@@ -629,6 +629,7 @@ void wlc_phy_detach(struct brcms_phy_pub *pih)
 		if (pi->pi_fptr.detach)
 			(pi->pi_fptr.detach)(pi);
 
+		wlc_phy_tbl_cache_flush(pi);
 		kfree(pi);
 	}
 }
@@ -725,6 +726,7 @@ void wlc_phy_por_inform(struct brcms_phy_pub *ppi)
 	struct brcms_phy *pi = (struct brcms_phy *) ppi;
 
 	pi->phy_init_por = true;
+	wlc_phy_tbl_cache_flush(pi);
 }
 
 void wlc_phy_edcrs_lock(struct brcms_phy_pub *pih, bool lock)
@@ -890,9 +892,12 @@ void wlc_phy_table_data_write(struct brcms_phy *pi, uint width, u32 val)
 	}
 }
 
-void
-wlc_phy_write_table(struct brcms_phy *pi, const struct phytbl_info *ptbl_info,
-		    u16 tblAddr, u16 tblDataHi, u16 tblDataLo)
+/* write entries [start, end) of a table, the address auto-increments */
+static void
+wlc_phy_write_table_range(struct brcms_phy *pi,
+			  const struct phytbl_info *ptbl_info,
+			  uint start, uint end,
+			  u16 tblAddr, u16 tblDataHi, u16 tblDataLo)
 {
 	uint idx;
 	uint tbl_id = ptbl_info->tbl_id;
@@ -902,9 +907,9 @@ wlc_phy_write_table(struct brcms_phy *pi, const struct phytbl_info *ptbl_info,
 	const u16 *ptbl_16b = (const u16 *)ptbl_info->tbl_ptr;
 	const u32 *ptbl_32b = (const u32 *)ptbl_info->tbl_ptr;
 
-	write_phy_reg(pi, tblAddr, (tbl_id << 10) | tbl_offset);
+	write_phy_reg(pi, tblAddr, (tbl_id << 10) | (tbl_offset + start));
 
-	for (idx = 0; idx < ptbl_info->tbl_len; idx++) {
+	for (idx = start; idx < end; idx++) {
 
 		if ((pi->sh->chip == BCM43224_CHIP_ID) &&
 		    (pi->sh->chiprev == 1) &&
@@ -927,6 +932,135 @@ wlc_phy_write_table(struct brcms_phy *pi, const struct phytbl_info *ptbl_info,
 	}
 }
 
+static u32 wlc_phy_tbl_entry(const void *tbl, uint width, uint idx)
+{
+	if (width == 32)
+		return ((const u32 *)tbl)[idx];
+	else if (width == 16)
+		return ((const u16 *)tbl)[idx];
+	else
+		return ((const u8 *)tbl)[idx];
+}
+
+static bool
+wlc_phy_tbl_cache_overlap(const struct phytbl_cache *ent,
+			  const struct phytbl_info *ptbl_info, u16 tblAddr)
+{
+	return ent->data && (ent->tbl_addr == tblAddr) &&
+	       (ent->tbl_id == ptbl_info->tbl_id) &&
+	       (ent->tbl_offset < ptbl_info->tbl_offset + ptbl_info->tbl_len) &&
+	       (ptbl_info->tbl_offset < ent->tbl_offset + ent->tbl_len);
+}
+
+static void wlc_phy_tbl_cache_drop(struct phytbl_cache *ent)
+{
+	kfree(ent->data);
+	ent->data = NULL;
+}
+
+/* forget every cached region a table access outside the cache touches */
+static void
+wlc_phy_tbl_cache_inval(struct brcms_phy *pi,
+			const struct phytbl_info *ptbl_info, u16 tblAddr)
+{
+	uint i;
+
+	for (i = 0; i < PHY_TBL_CACHE_SZ; i++)
+		if (wlc_phy_tbl_cache_overlap(&pi->tbl_cache[i], ptbl_info,
+					      tblAddr))
+			wlc_phy_tbl_cache_drop(&pi->tbl_cache[i]);
+}
+
+/* tables are lost on POR, after which nothing cached may be trusted */
+void wlc_phy_tbl_cache_flush(struct brcms_phy *pi)
+{
+	uint i;
+
+	for (i = 0; i < PHY_TBL_CACHE_SZ; i++)
+		wlc_phy_tbl_cache_drop(&pi->tbl_cache[i]);
+	pi->tbl_cache_next = 0;
+}
+
+void
+wlc_phy_write_table(struct brcms_phy *pi, const struct phytbl_info *ptbl_info,
+		    u16 tblAddr, u16 tblDataHi, u16 tblDataLo)
+{
+	wlc_phy_tbl_cache_inval(pi, ptbl_info, tblAddr);
+	wlc_phy_write_table_range(pi, ptbl_info, 0, ptbl_info->tbl_len,
+				  tblAddr, tblDataHi, tblDataLo);
+}
+
+/*
+ * Like wlc_phy_write_table(), for tables that are (re)loaded in bulk on
+ * init, band and channel changes. The region written is shadowed, and a
+ * later write of the same region only touches the runs of entries that
+ * differ from what the hardware already holds, so reloading an unchanged
+ * table costs no register writes at all.
+ */
+void
+wlc_phy_write_table_cached(struct brcms_phy *pi,
+			   const struct phytbl_info *ptbl_info,
+			   u16 tblAddr, u16 tblDataHi, u16 tblDataLo)
+{
+	struct phytbl_cache *ent = NULL;
+	uint len = ptbl_info->tbl_len;
+	uint width = ptbl_info->tbl_width;
+	uint i, idx, start;
+
+	for (i = 0; i < PHY_TBL_CACHE_SZ; i++) {
+		struct phytbl_cache *e = &pi->tbl_cache[i];
+
+		if (!wlc_phy_tbl_cache_overlap(e, ptbl_info, tblAddr))
+			continue;
+
+		if (!ent && (e->tbl_offset == ptbl_info->tbl_offset) &&
+		    (e->tbl_len == len) && (e->tbl_width == width))
+			ent = e;
+		else
+			wlc_phy_tbl_cache_drop(e);
+	}
+
+	if (ent) {
+		for (idx = 0; idx < len;) {
+			if (wlc_phy_tbl_entry(ent->data, width, idx) ==
+			    wlc_phy_tbl_entry(ptbl_info->tbl_ptr, width, idx)) {
+				idx++;
+				continue;
+			}
+
+			start = idx;
+			while ((idx < len) &&
+			       (wlc_phy_tbl_entry(ent->data, width, idx) !=
+				wlc_phy_tbl_entry(ptbl_info->tbl_ptr, width,
+						  idx)))
+				idx++;
+
+			wlc_phy_write_table_range(pi, ptbl_info, start, idx,
+						  tblAddr, tblDataHi,
+						  tblDataLo);
+		}
+		memcpy(ent->data, ptbl_info->tbl_ptr, len * (width / 8));
+		return;
+	}
+
+	wlc_phy_write_table_range(pi, ptbl_info, 0, len,
+				  tblAddr, tblDataHi, tblDataLo);
+
+	ent = &pi->tbl_cache[pi->tbl_cache_next];
+	pi->tbl_cache_next = (pi->tbl_cache_next + 1) % PHY_TBL_CACHE_SZ;
+
+	kfree(ent->data);
+	ent->data = kmemdup(ptbl_info->tbl_ptr, len * (width / 8), GFP_ATOMIC);
+	if (ent->data == NULL)
+		return;
+
+	ent->tbl_addr = tblAddr;
+	ent->tbl_id = ptbl_info->tbl_id;
+	ent->tbl_offset = ptbl_info->tbl_offset;
+	ent->tbl_len = len;
+	ent->tbl_width = width;
+}
+
 void
 wlc_phy_read_table(struct brcms_phy *pi, const struct phytbl_info *ptbl_info,
 		   u16 tblAddr, u16 tblDataHi, u16 tblDataLo)
@@ -939,6 +1073,9 @@ wlc_phy_read_table(struct brcms_phy *pi, const struct phytbl_info *ptbl_info,
 	u16 *ptbl_16b = (u16 *)ptbl_info->tbl_ptr;
 	u32 *ptbl_32b = (u32 *)ptbl_info->tbl_ptr;
 
+	/* a region that is read back may be updated by the hardware */
+	wlc_phy_tbl_cache_inval(pi, ptbl_info, tblAddr);
+
 	write_phy_reg(pi, tblAddr, (tbl_id << 10) | tbl_offset);
 
 	for (idx = 0; idx < ptbl_info->tbl_len; idx++) {
@@ -261,6 +261,18 @@ struct phytbl_info {
 	u32 tbl_width;
 };
 
+#define PHY_TBL_CACHE_SZ	48
+
+/* shadow of a table region last written by wlc_phy_write_table_cached() */
+struct phytbl_cache {
+	u16 tbl_addr;
+	u32 tbl_id;
+	u32 tbl_offset;
+	u32 tbl_len;
+	u32 tbl_width;
+	void *data;		/* what the hardware holds, NULL if unused */
+};
+
 struct interference_info {
 	u8 curr_home_channel;
 	u16 crsminpwrthld_40_stored;
@@ -877,6 +889,9 @@ struct brcms_phy {
 	uint tbl_save_id;
 	uint tbl_save_offset;
 
+	struct phytbl_cache tbl_cache[PHY_TBL_CACHE_SZ];
+	uint tbl_cache_next;
+
 	u8 txpwrctrl;
 	s8 txpwrindex[PHY_CORE_MAX];
 
@@ -940,6 +955,11 @@ extern void wlc_phy_read_table(struct brcms_phy *pi,
 extern void wlc_phy_write_table(struct brcms_phy *pi,
 				const struct phytbl_info *ptbl_info,
 				u16 tblAddr, u16 tblDataHi, u16 tblDatalo);
+extern void wlc_phy_write_table_cached(struct brcms_phy *pi,
+				       const struct phytbl_info *ptbl_info,
+				       u16 tblAddr, u16 tblDataHi,
+				       u16 tblDatalo);
+extern void wlc_phy_tbl_cache_flush(struct brcms_phy *pi);
 extern void wlc_phy_table_addr(struct brcms_phy *pi, uint tbl_id,
 			       uint tbl_offset, u16 tblAddr, u16 tblDataHi,
 			       u16 tblDataLo);
@@ -1035,6 +1055,8 @@ extern void wlc_phy_txpower_recalc_target(struct brcms_phy *pi);
 
 extern void wlc_lcnphy_write_table(struct brcms_phy *pi,
 				   const struct phytbl_info *pti);
+extern void wlc_lcnphy_write_table_cached(struct brcms_phy *pi,
+					  const struct phytbl_info *pti);
 extern void wlc_lcnphy_read_table(struct brcms_phy *pi,
 				  struct phytbl_info *pti);
 extern void wlc_lcnphy_set_tx_iqcc(struct brcms_phy *pi, u16 a, u16 b);
@@ -1070,6 +1092,9 @@ extern void wlc_nphy_deaf_mode(struct brcms_phy *pi, bool mode);
 #define wlc_phy_write_table_nphy(pi, pti) \
 	wlc_phy_write_table(pi, pti, 0x72, 0x74, 0x73)
 
+#define wlc_phy_write_table_cached_nphy(pi, pti) \
+	wlc_phy_write_table_cached(pi, pti, 0x72, 0x74, 0x73)
+
 #define wlc_phy_read_table_nphy(pi, pti) \
 	wlc_phy_read_table(pi, pti, 0x72, 0x74, 0x73)
 
@@ -1083,6 +1108,8 @@ extern void wlc_phy_table_read_nphy(struct brcms_phy *pi, u32, u32 l, u32 o,
 				    u32 w, void *d);
 extern void wlc_phy_table_write_nphy(struct brcms_phy *pi, u32, u32, u32,
 				     u32, const void *);
+extern void wlc_phy_table_write_cached_nphy(struct brcms_phy *pi, u32, u32,
+					    u32, u32, const void *);
 
 #define	PHY_IPA(pi) \
 	((pi->ipa2g_on && CHSPEC_IS2G(pi->radio_chanspec)) || \
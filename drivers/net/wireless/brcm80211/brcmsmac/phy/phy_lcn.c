@@ -979,6 +979,12 @@ void wlc_lcnphy_write_table(struct brcms_phy *pi, const struct phytbl_info *pti)
 	wlc_phy_write_table(pi, pti, 0x455, 0x457, 0x456);
 }
 
+void wlc_lcnphy_write_table_cached(struct brcms_phy *pi,
+				   const struct phytbl_info *pti)
+{
+	wlc_phy_write_table_cached(pi, pti, 0x455, 0x457, 0x456);
+}
+
 void wlc_lcnphy_read_table(struct brcms_phy *pi, struct phytbl_info *pti)
 {
 	wlc_phy_read_table(pi, pti, 0x455, 0x457, 0x456);
@@ -3355,7 +3361,7 @@ wlc_lcnphy_start_tx_tone(struct brcms_phy *pi, s32 f_kHz, u16 max_val,
 	u16 num_samps, t, k;
 	u32 bw;
 	s32 theta = 0, rot = 0;
-	struct cordic_iq tone_samp;
+	struct cordic_iq tone_buf[64];
 	u32 data_buf[64];
 	u16 i_samp, q_samp;
 	struct phytbl_info tab;
@@ -3386,14 +3392,11 @@ wlc_lcnphy_start_tx_tone(struct brcms_phy *pi, s32 f_kHz, u16 max_val,
 	rot = ((f_kHz * 36) / phy_bw) / 100;
 	theta = 0;
 
-	for (t = 0; t < num_samps; t++) {
-
-		tone_samp = cordic_calc_iq(theta);
+	qm_cordic_tone(theta, rot, tone_buf, num_samps);
 
-		theta += rot;
-
-		i_samp = (u16) (FLOAT(tone_samp.i * max_val) & 0x3ff);
-		q_samp = (u16) (FLOAT(tone_samp.q * max_val) & 0x3ff);
+	for (t = 0; t < num_samps; t++) {
+		i_samp = (u16) (FLOAT(tone_buf[t].i * max_val) & 0x3ff);
+		q_samp = (u16) (FLOAT(tone_buf[t].q * max_val) & 0x3ff);
 		data_buf[t] = (i_samp << 10) | q_samp;
 	}
 
@@ -4337,51 +4340,60 @@ wlc_lcnphy_load_tx_gain_table(struct brcms_phy *pi,
 	}
 }
 
+#define LCNPHY_RFPOWER_CHUNK	32
+
 static void wlc_lcnphy_load_rfpower(struct brcms_phy *pi)
 {
 	struct phytbl_info tab;
-	u32 val, bbmult, rfgain;
-	u8 index;
+	u32 buf[LCNPHY_RFPOWER_CHUNK];
+	s16 log10_bbmult[LCNPHY_RFPOWER_CHUNK], q_bbmult[LCNPHY_RFPOWER_CHUNK];
+	u8 index, base, i;
 	u8 scale_factor = 1;
-	s16 temp, temp1, temp2, qQ, qQ1, qQ2, shift;
+	s16 temp, temp1, temp2, qQ, qQ1, qQ2, qQ64, log10_64, shift;
 
 	tab.tbl_id = LCNPHY_TBL_ID_TXPWRCTL;
 	tab.tbl_width = 32;
-	tab.tbl_len = 1;
+	tab.tbl_len = LCNPHY_RFPOWER_CHUNK;
+	tab.tbl_ptr = buf;
 
-	for (index = 0; index < 128; index++) {
-		tab.tbl_ptr = &bbmult;
-		tab.tbl_offset = LCNPHY_TX_PWR_CTRL_IQ_OFFSET + index;
-		wlc_lcnphy_read_table(pi, &tab);
-		bbmult = bbmult >> 20;
+	qm_log10((s32) (1 << 6), 0, &log10_64, &qQ64);
 
-		tab.tbl_ptr = &rfgain;
-		tab.tbl_offset = LCNPHY_TX_PWR_CTRL_GAIN_OFFSET + index;
+	for (base = 0; base < 128; base += LCNPHY_RFPOWER_CHUNK) {
+		tab.tbl_offset = LCNPHY_TX_PWR_CTRL_IQ_OFFSET + base;
 		wlc_lcnphy_read_table(pi, &tab);
+		for (i = 0; i < LCNPHY_RFPOWER_CHUNK; i++)
+			buf[i] = buf[i] >> 20;
+
+		qm_log10_array((s32 *) buf, 0, log10_bbmult, q_bbmult,
+			       LCNPHY_RFPOWER_CHUNK);
+
+		for (i = 0; i < LCNPHY_RFPOWER_CHUNK; i++) {
+			index = base + i;
+			temp1 = log10_bbmult[i];
+			qQ1 = q_bbmult[i];
+			temp2 = log10_64;
+			qQ2 = qQ64;
+
+			if (qQ1 < qQ2) {
+				temp2 = qm_shr16(temp2, qQ2 - qQ1);
+				qQ = qQ1;
+			} else {
+				temp1 = qm_shr16(temp1, qQ1 - qQ2);
+				qQ = qQ2;
+			}
+			temp = qm_sub16(temp1, temp2);
 
-		qm_log10((s32) (bbmult), 0, &temp1, &qQ1);
-		qm_log10((s32) (1 << 6), 0, &temp2, &qQ2);
+			if (qQ >= 4)
+				shift = qQ - 4;
+			else
+				shift = 4 - qQ;
 
-		if (qQ1 < qQ2) {
-			temp2 = qm_shr16(temp2, qQ2 - qQ1);
-			qQ = qQ1;
-		} else {
-			temp1 = qm_shr16(temp1, qQ1 - qQ2);
-			qQ = qQ2;
+			buf[i] = (((index << shift) + (5 * temp) +
+				   (1 << (scale_factor + shift - 3))) >>
+				  (scale_factor + shift - 2));
 		}
-		temp = qm_sub16(temp1, temp2);
 
-		if (qQ >= 4)
-			shift = qQ - 4;
-		else
-			shift = 4 - qQ;
-
-		val = (((index << shift) + (5 * temp) +
-			(1 << (scale_factor + shift - 3))) >> (scale_factor +
-							       shift - 2));
-
-		tab.tbl_ptr = &val;
-		tab.tbl_offset = LCNPHY_TX_PWR_CTRL_PWR_OFFSET + index;
+		tab.tbl_offset = LCNPHY_TX_PWR_CTRL_PWR_OFFSET + base;
 		wlc_lcnphy_write_table(pi, &tab);
 	}
 }
@@ -4621,7 +4633,7 @@ static void wlc_lcnphy_tbl_init(struct brcms_phy *pi)
 		}
 
 		for (idx = 0; idx < l; idx++)
-			wlc_lcnphy_write_table(pi, &tb[idx]);
+			wlc_lcnphy_write_table_cached(pi, &tb[idx]);
 	}
 
 	if ((pi->sh->boardflags & BFL_FEM)
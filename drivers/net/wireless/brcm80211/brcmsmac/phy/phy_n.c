@@ -25,6 +25,7 @@
 #include <d11.h>
 #include <phy_shim.h>
 #include "phy_int.h"
+#include "phy_qmath.h"
 #include "phy_hal.h"
 #include "phy_radio.h"
 #include "phyreg_n.h"
@@ -14169,6 +14170,20 @@ wlc_phy_table_write_nphy(struct brcms_phy *pi, u32 id, u32 len, u32 offset,
 	wlc_phy_write_table_nphy(pi, &tbl);
 }
 
+void
+wlc_phy_table_write_cached_nphy(struct brcms_phy *pi, u32 id, u32 len,
+				u32 offset, u32 width, const void *data)
+{
+	struct phytbl_info tbl;
+
+	tbl.tbl_id = id;
+	tbl.tbl_len = len;
+	tbl.tbl_offset = offset;
+	tbl.tbl_width = width;
+	tbl.tbl_ptr = data;
+	wlc_phy_write_table_cached_nphy(pi, &tbl);
+}
+
 void
 wlc_phy_table_read_nphy(struct brcms_phy *pi, u32 id, u32 len, u32 offset,
 			u32 width, void *data)
@@ -14293,25 +14308,25 @@ static void wlc_phy_tbl_init_nphy(struct brcms_phy *pi)
 					pi->srom_fem5g.antswctrllut;
 				switch (antswctrllut) {
 				case 0:
-					wlc_phy_write_table_nphy(
+					wlc_phy_write_table_cached_nphy(
 						pi,
 						&mimophytbl_info_rev3_volatile
 						[idx]);
 					break;
 				case 1:
-					wlc_phy_write_table_nphy(
+					wlc_phy_write_table_cached_nphy(
 						pi,
 						&mimophytbl_info_rev3_volatile1
 						[idx]);
 					break;
 				case 2:
-					wlc_phy_write_table_nphy(
+					wlc_phy_write_table_cached_nphy(
 						pi,
 						&mimophytbl_info_rev3_volatile2
 						[idx]);
 					break;
 				case 3:
-					wlc_phy_write_table_nphy(
+					wlc_phy_write_table_cached_nphy(
 						pi,
 						&mimophytbl_info_rev3_volatile3
 						[idx]);
@@ -14320,16 +14335,15 @@ static void wlc_phy_tbl_init_nphy(struct brcms_phy *pi)
 					break;
 				}
 			} else {
-				wlc_phy_write_table_nphy(
+				wlc_phy_write_table_cached_nphy(
 					pi,
 					&mimophytbl_info_rev3_volatile[idx]);
 			}
 		}
 	} else {
 		for (idx = 0; idx < mimophytbl_info_sz_rev0_volatile; idx++)
-			wlc_phy_write_table_nphy(pi,
-						 &mimophytbl_info_rev0_volatile
-						 [idx]);
+			wlc_phy_write_table_cached_nphy(
+				pi, &mimophytbl_info_rev0_volatile[idx]);
 	}
 }
 
@@ -18003,15 +18017,15 @@ static void wlc_phy_txpwrctrl_pwr_setup_nphy(struct brcms_phy *pi)
 			}
 			regval[idx] = (u32) pwr_est;
 		}
-		wlc_phy_table_write_nphy(pi, tbl_id, tbl_len, tbl_offset, 32,
-					 regval);
+		wlc_phy_table_write_cached_nphy(pi, tbl_id, tbl_len,
+						tbl_offset, 32, regval);
 	}
 
 	wlc_phy_txpwr_limit_to_tbl_nphy(pi);
-	wlc_phy_table_write_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL, 84, 64, 8,
-				 pi->adj_pwr_tbl_nphy);
-	wlc_phy_table_write_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL, 84, 64, 8,
-				 pi->adj_pwr_tbl_nphy);
+	wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL, 84, 64,
+					8, pi->adj_pwr_tbl_nphy);
+	wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL, 84, 64,
+					8, pi->adj_pwr_tbl_nphy);
 
 	if (pi->phyhang_avoid)
 		wlc_phy_stay_in_carriersearch_nphy(pi, false);
@@ -19611,7 +19625,7 @@ void wlc_phy_init_nphy(struct brcms_phy *pi)
 		u16 idx;
 		s16 pga_gn = 0;
 		s16 pad_gn = 0;
-		s32 rfpwr_offset;
+		s32 rfpwr_offset[128];
 
 		if (PHY_IPA(pi)) {
 			tx_pwrctrl_tbl = wlc_phy_get_ipa_gaintbl_nphy(pi);
@@ -19649,10 +19663,10 @@ void wlc_phy_init_nphy(struct brcms_phy *pi)
 			}
 		}
 
-		wlc_phy_table_write_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL, 128,
-					 192, 32, tx_pwrctrl_tbl);
-		wlc_phy_table_write_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL, 128,
-					 192, 32, tx_pwrctrl_tbl);
+		wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL,
+						128, 192, 32, tx_pwrctrl_tbl);
+		wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL,
+						128, 192, 32, tx_pwrctrl_tbl);
 
 		pi->nphy_gmval = (u16) ((*tx_pwrctrl_tbl >> 16) & 0x7000);
 
@@ -19661,51 +19675,36 @@ void wlc_phy_init_nphy(struct brcms_phy *pi)
 			for (idx = 0; idx < 128; idx++) {
 				pga_gn = (tx_pwrctrl_tbl[idx] >> 24) & 0xf;
 				pad_gn = (tx_pwrctrl_tbl[idx] >> 19) & 0x1f;
-				rfpwr_offset = get_rf_pwr_offset(pi, pga_gn,
-								 pad_gn);
-				wlc_phy_table_write_nphy(
-					pi,
-					NPHY_TBL_ID_CORE1TXPWRCTL,
-					1, 576 + idx, 32,
-					&rfpwr_offset);
-				wlc_phy_table_write_nphy(
-					pi,
-					NPHY_TBL_ID_CORE2TXPWRCTL,
-					1, 576 + idx, 32,
-					&rfpwr_offset);
+				rfpwr_offset[idx] = get_rf_pwr_offset(pi,
+								      pga_gn,
+								      pad_gn);
 			}
 		} else {
 
 			for (idx = 0; idx < 128; idx++) {
 				pga_gn = (tx_pwrctrl_tbl[idx] >> 24) & 0xf;
 				if (CHSPEC_IS2G(pi->radio_chanspec))
-					rfpwr_offset = (s16)
+					rfpwr_offset[idx] = (s16)
 						 nphy_papd_pga_gain_delta_ipa_2g
 								       [pga_gn];
 				else
-					rfpwr_offset = (s16)
+					rfpwr_offset[idx] = (s16)
 						 nphy_papd_pga_gain_delta_ipa_5g
 								       [pga_gn];
-
-				wlc_phy_table_write_nphy(
-					pi,
-					NPHY_TBL_ID_CORE1TXPWRCTL,
-					1, 576 + idx, 32,
-					&rfpwr_offset);
-				wlc_phy_table_write_nphy(
-					pi,
-					NPHY_TBL_ID_CORE2TXPWRCTL,
-					1, 576 + idx, 32,
-					&rfpwr_offset);
 			}
 
 		}
+
+		wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL,
+						128, 576, 32, rfpwr_offset);
+		wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL,
+						128, 576, 32, rfpwr_offset);
 	} else {
 
-		wlc_phy_table_write_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL, 128,
-					 192, 32, nphy_tpc_txgain);
-		wlc_phy_table_write_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL, 128,
-					 192, 32, nphy_tpc_txgain);
+		wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE1TXPWRCTL,
+						128, 192, 32, nphy_tpc_txgain);
+		wlc_phy_table_write_cached_nphy(pi, NPHY_TBL_ID_CORE2TXPWRCTL,
+						128, 192, 32, nphy_tpc_txgain);
 	}
 
 	if (pi->sh->phyrxchain != 0x3)
@@ -23288,12 +23287,9 @@ wlc_phy_gen_load_samples_nphy(struct brcms_phy *pi, u32 f_kHz, u16 max_val,
 	rot = ((f_kHz * 36) / phy_bw) / 100;
 	theta = 0;
 
-	for (t = 0; t < num_samps; t++) {
-
-		tone_buf[t] = cordic_calc_iq(theta);
-
-		theta += rot;
+	qm_cordic_tone(theta, rot, tone_buf, num_samps);
 
+	for (t = 0; t < num_samps; t++) {
 		tone_buf[t].q = (s32) FLOAT(tone_buf[t].q * max_val);
 		tone_buf[t].i = (s32) FLOAT(tone_buf[t].i * max_val);
 	}
@@ -14,6 +14,8 @@
  * CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <linux/cordic.h>
+
 #include "phy_qmath.h"
 
 /*
@@ -306,3 +308,46 @@ void qm_log10(s32 N, s16 qN, s16 *log10N, s16 *qLog10N)
 
 	return;
 }
+
+/*
+ * Description: This function computes qm_log10() of n numbers of the same
+ * qformat qN, writing log10 of N[i] to log10N[i] and its qformat to
+ * qLog10N[i].
+ */
+void qm_log10_array(const s32 *N, s16 qN, s16 *log10N, s16 *qLog10N, uint n)
+{
+	uint i;
+
+	for (i = 0; i < n; i++)
+		qm_log10(N[i], qN, &log10N[i], &qLog10N[i]);
+}
+
+/*
+ * Description: This function computes the n i/q samples of a tone starting
+ * at angle theta and advancing by rot degrees per sample, i.e. it is
+ * equivalent to calling cordic_calc_iq() for theta, theta + rot,
+ * theta + 2 * rot and so on. As cordic_calc_iq() reduces its input modulo
+ * 360 degrees, the samples repeat once the angle comes back to where it
+ * started, so the cordic is only run for the first period and the rest is
+ * copied. The angle is kept reduced, which also keeps it from overflowing
+ * the cordic fixed point format for long tones.
+ */
+void qm_cordic_tone(s32 theta, s32 rot, struct cordic_iq *coord, uint n)
+{
+	uint t, period = n;
+	s32 start;
+
+	theta = ((theta % 360) + 360) % 360;
+	rot = ((rot % 360) + 360) % 360;
+	start = theta;
+
+	for (t = 0; t < period; t++) {
+		coord[t] = cordic_calc_iq(theta);
+		theta = (theta + rot) % 360;
+		if (theta == start)
+			period = t + 1;
+	}
+
+	for (; t < n; t++)
+		coord[t] = coord[t - period];
+}
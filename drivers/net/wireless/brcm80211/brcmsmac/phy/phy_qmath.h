@@ -19,6 +19,8 @@
 
 #include <types.h>
 
+struct cordic_iq;
+
 u16 qm_mulu16(u16 op1, u16 op2);
 
 s16 qm_muls16(s16 op1, s16 op2);
@@ -39,4 +41,8 @@ s16 qm_norm32(s32 op);
 
 void qm_log10(s32 N, s16 qN, s16 *log10N, s16 *qLog10N);
 
+void qm_log10_array(const s32 *N, s16 qN, s16 *log10N, s16 *qLog10N, uint n);
+
+void qm_cordic_tone(s32 theta, s32 rot, struct cordic_iq *coord, uint n);
+
 #endif				/* #ifndef _BRCM_QMATH_H_ */
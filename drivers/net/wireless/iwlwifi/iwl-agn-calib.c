@@ -84,29 +84,32 @@ struct statistics_general_data {
 
 int iwl_send_calib_results(struct iwl_priv *priv)
 {
-	int ret = 0;
-	int i = 0;
+	struct iwl_host_cmd hcmd[IWL_CALIB_MAX];
+	int ret;
+	int i, num = 0;
 
-	struct iwl_host_cmd hcmd = {
-		.id = REPLY_PHY_CALIBRATION_CMD,
-		.flags = CMD_SYNC,
-	};
+	memset(hcmd, 0, sizeof(hcmd));
 
 	for (i = 0; i < IWL_CALIB_MAX; i++) {
 		if ((BIT(i) & hw_params(priv).calib_init_cfg) &&
 		    priv->calib_results[i].buf) {
-			hcmd.len[0] = priv->calib_results[i].buf_len;
-			hcmd.data[0] = priv->calib_results[i].buf;
-			hcmd.dataflags[0] = IWL_HCMD_DFL_NOCOPY;
-			ret = iwl_trans_send_cmd(trans(priv), &hcmd);
-			if (ret) {
-				IWL_ERR(priv, "Error %d iteration %d\n",
-					ret, i);
-				break;
-			}
+			hcmd[num].id = REPLY_PHY_CALIBRATION_CMD;
+			hcmd[num].len[0] = priv->calib_results[i].buf_len;
+			hcmd[num].data[0] = priv->calib_results[i].buf;
+			hcmd[num].dataflags[0] = IWL_HCMD_DFL_NOCOPY;
+			num++;
 		}
 	}
 
+	if (!num)
+		return 0;
+
+	/* results are independent, push them all and wait only once */
+	ret = iwl_trans_send_cmd_batch(trans(priv), hcmd, num);
+	if (ret)
+		IWL_ERR(priv, "Error %d sending %d calibration results\n",
+			ret, num);
+
 	return ret;
 }
 
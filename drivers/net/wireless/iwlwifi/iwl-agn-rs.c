@@ -917,6 +917,10 @@ static void rs_tx_status(void *priv_r, struct ieee80211_supported_band *sband,
 	struct iwl_scale_tbl_info *curr_tbl, *other_tbl, *tmp_tbl;
 	struct iwl_station_priv *sta_priv = (void *)sta->drv_priv;
 	struct iwl_rxon_context *ctx = sta_priv->ctx;
+	bool clean_tx = false;
+#ifdef CONFIG_MAC80211_DEBUGFS
+	ktime_t start;
+#endif
 
 	IWL_DEBUG_RATE_LIMIT(priv, "get frame ack response, update rate scale window\n");
 
@@ -1073,14 +1077,43 @@ static void rs_tx_status(void *priv_r, struct ieee80211_supported_band *sband,
 			lq_sta->total_success += legacy_success;
 			lq_sta->total_failed += retries + (1 - legacy_success);
 		}
+		clean_tx = legacy_success && !retries;
 	}
 	/* The last TX rate is cached in lq_sta; it's set in if/else above */
 	lq_sta->last_rate_n_flags = tx_rate;
+
+	/*
+	 * A frame acked on its first attempt while we stay in the current
+	 * table cannot trigger anything but a rate increase, so only count
+	 * it and let the decision wait for a few more of them.  Failures,
+	 * retries, A-MPDU status and table searches are evaluated at once.
+	 */
+	if (clean_tx && lq_sta->stay_in_tbl && !lq_sta->search_better_tbl &&
+	    ++lq_sta->deferred_frames < IWL_RS_DECISION_FRAMES) {
+		rs_tl_add_packet(lq_sta, hdr);
+		/* keep the time-in-table accounting of rs_stay_in_table() */
+		lq_sta->table_count++;
+#ifdef CONFIG_MAC80211_DEBUGFS
+		lq_sta->dbg_deferred++;
+#endif
+		goto out;
+	}
 done:
+	lq_sta->deferred_frames = 0;
+
 	/* See if there's a better rate or modulation mode to try. */
-	if (sta && sta->supp_rates[sband->band])
+	if (sta && sta->supp_rates[sband->band]) {
+#ifdef CONFIG_MAC80211_DEBUGFS
+		start = ktime_get();
+#endif
 		rs_rate_scale_perform(priv, skb, sta, lq_sta);
-
+#ifdef CONFIG_MAC80211_DEBUGFS
+		lq_sta->dbg_rs_time_ns +=
+			ktime_to_ns(ktime_sub(ktime_get(), start));
+		lq_sta->dbg_decisions++;
+#endif
+	}
+out:
 #if defined(CONFIG_MAC80211_DEBUGFS) && defined(CONFIG_IWLWIFI_DEVICE_SVTOOL)
 	if ((priv->tm_fixed_rate) &&
 	    (priv->tm_fixed_rate != lq_sta->dbg_fixed_rate))
@@ -3155,7 +3188,7 @@ static ssize_t rs_sta_dbgfs_scale_table_read(struct file *file,
 	struct iwl_scale_tbl_info *tbl = &(lq_sta->lq_info[lq_sta->active_tbl]);
 
 	priv = lq_sta->drv;
-	buff = kmalloc(1024, GFP_KERNEL);
+	buff = kmalloc(2048, GFP_KERNEL);
 	if (!buff)
 		return -ENOMEM;
 
@@ -3216,6 +3249,10 @@ static ssize_t rs_sta_dbgfs_scale_table_read(struct file *file,
 				iwl_rate_mcs[index].mbps, iwl_rate_mcs[index].mcs);
 		}
 	}
+	desc += sprintf(buff+desc, "rs: decisions=%u deferred=%u "
+			"cpu=%llu us\n", lq_sta->dbg_decisions,
+			lq_sta->dbg_deferred,
+			div_u64(lq_sta->dbg_rs_time_ns, NSEC_PER_USEC));
 
 	ret = simple_read_from_buffer(user_buf, count, ppos, buff, desc);
 	kfree(buff);
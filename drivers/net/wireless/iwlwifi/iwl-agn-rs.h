@@ -217,6 +217,9 @@ enum {
 #define IWL_NONE_LEGACY_SUCCESS_LIMIT	4500
 #define IWL_NONE_LEGACY_TABLE_COUNT	1500
 
+/* Clean single-shot legacy frames collected before re-running rate scaling */
+#define IWL_RS_DECISION_FRAMES		8
+
 /* Success ratio (ACKed / attempted tx frames) values (perfect is 128 * 100) */
 #define IWL_RS_GOOD_RATIO		12800	/* 100% */
 #define IWL_RATE_SCALE_SWITCH		10880	/*  85% */
@@ -382,6 +385,7 @@ struct iwl_lq_sta {
 	u32 max_failure_limit;	/* # failed frames before new search */
 	u32 max_success_limit;	/* # successful frames before new search */
 	u32 table_count;
+	u32 deferred_frames;	/* clean frames since last rate decision */
 	u32 total_failed;	/* total failed frames, any/all rates */
 	u32 total_success;	/* total successful frames, any/all rates */
 	u64 flush_timer;	/* time staying in mode before new search */
@@ -410,6 +414,9 @@ struct iwl_lq_sta {
 	struct dentry *rs_sta_dbgfs_rate_scale_data_file;
 	struct dentry *rs_sta_dbgfs_tx_agg_tid_en_file;
 	u32 dbg_fixed_rate;
+	u32 dbg_decisions;	/* rs_rate_scale_perform() runs */
+	u32 dbg_deferred;	/* frames that only updated the history */
+	u64 dbg_rs_time_ns;	/* time spent in rs_rate_scale_perform() */
 #endif
 	struct iwl_priv *drv;
 
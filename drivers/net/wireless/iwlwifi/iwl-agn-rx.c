@@ -752,6 +752,13 @@ static int iwlagn_set_decrypted_flag(struct iwl_priv *priv,
 	return 0;
 }
 
+/*
+ * Frames up to this size are copied out of the RX buffer. The page then
+ * stays with the transport, which maps it again for the next frame instead
+ * of allocating a new one.
+ */
+#define IWL_RX_COPYBREAK	256
+
 static void iwlagn_pass_packet_to_mac80211(struct iwl_priv *priv,
 					struct ieee80211_hdr *hdr,
 					u16 len,
@@ -775,13 +782,24 @@ static void iwlagn_pass_packet_to_mac80211(struct iwl_priv *priv,
 	    iwlagn_set_decrypted_flag(priv, hdr, ampdu_status, stats))
 		return;
 
-	skb = dev_alloc_skb(128);
-	if (!skb) {
-		IWL_ERR(priv, "dev_alloc_skb failed\n");
-		return;
-	}
+	if (len <= IWL_RX_COPYBREAK) {
+		skb = dev_alloc_skb(len);
+		if (!skb) {
+			IWL_ERR(priv, "dev_alloc_skb failed\n");
+			return;
+		}
 
-	skb_add_rx_frag(skb, 0, rxb->page, (void *)hdr - rxb_addr(rxb), len);
+		memcpy(skb_put(skb, len), hdr, len);
+	} else {
+		skb = dev_alloc_skb(128);
+		if (!skb) {
+			IWL_ERR(priv, "dev_alloc_skb failed\n");
+			return;
+		}
+
+		skb_add_rx_frag(skb, 0, rxb->page,
+				(void *)hdr - rxb_addr(rxb), len);
+	}
 
 	iwl_update_stats(priv, false, fc, len);
 
@@ -808,7 +826,10 @@ static void iwlagn_pass_packet_to_mac80211(struct iwl_priv *priv,
 	memcpy(IEEE80211_SKB_RXCB(skb), stats, sizeof(*stats));
 
 	ieee80211_rx(priv->hw, skb);
-	rxb->page = NULL;
+
+	/* The page now belongs to the skb unless the frame was copied */
+	if (len > IWL_RX_COPYBREAK)
+		rxb->page = NULL;
 }
 
 static u32 iwlagn_translate_rx_status(struct iwl_priv *priv, u32 decrypt_in)
@@ -421,6 +421,7 @@
  */
 #define RX_FREE_BUFFERS 64
 #define RX_LOW_WATERMARK 8
+#define RX_REPLENISH_BATCH 16
 
 /**
  * struct iwl_rb_status - reseve buffer status
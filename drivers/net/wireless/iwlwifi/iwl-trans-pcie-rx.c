@@ -243,8 +243,12 @@ static void iwlagn_rx_queue_restock(struct iwl_trans *trans)
  *
  * Also restock the Rx queue via iwl_rx_queue_restock.
  * This is called as a scheduled work item (except for during initialization)
+ *
+ * At most @budget buffers are allocated, which bounds the time spent here
+ * when called from the interrupt tasklet.
  */
-static void iwlagn_rx_allocate(struct iwl_trans *trans, gfp_t priority)
+static void iwlagn_rx_allocate(struct iwl_trans *trans, gfp_t priority,
+			       unsigned int budget)
 {
 	struct iwl_trans_pcie *trans_pcie =
 		IWL_TRANS_GET_PCIE_TRANS(trans);
@@ -256,7 +260,7 @@ static void iwlagn_rx_allocate(struct iwl_trans *trans, gfp_t priority)
 	unsigned long flags;
 	gfp_t gfp_mask = priority;
 
-	while (1) {
+	while (budget--) {
 		spin_lock_irqsave(&rxq->lock, flags);
 		if (list_empty(&rxq->rx_used)) {
 			spin_unlock_irqrestore(&rxq->lock, flags);
@@ -329,16 +333,17 @@ void iwlagn_rx_replenish(struct iwl_trans *trans)
 {
 	unsigned long flags;
 
-	iwlagn_rx_allocate(trans, GFP_KERNEL);
+	iwlagn_rx_allocate(trans, GFP_KERNEL, RX_QUEUE_SIZE + RX_FREE_BUFFERS);
 
 	spin_lock_irqsave(&trans->shrd->lock, flags);
 	iwlagn_rx_queue_restock(trans);
 	spin_unlock_irqrestore(&trans->shrd->lock, flags);
 }
 
-static void iwlagn_rx_replenish_now(struct iwl_trans *trans)
+static void iwlagn_rx_replenish_now(struct iwl_trans *trans,
+				    unsigned int budget)
 {
-	iwlagn_rx_allocate(trans, GFP_ATOMIC);
+	iwlagn_rx_allocate(trans, GFP_ATOMIC, budget);
 
 	iwlagn_rx_queue_restock(trans);
 }
@@ -503,7 +508,8 @@ static void iwl_rx_handle(struct iwl_trans *trans)
 			count++;
 			if (count >= 8) {
 				rxq->read = i;
-				iwlagn_rx_replenish_now(trans);
+				iwlagn_rx_replenish_now(trans,
+					RX_QUEUE_SIZE + RX_FREE_BUFFERS);
 				count = 0;
 			}
 		}
@@ -512,7 +518,15 @@ static void iwl_rx_handle(struct iwl_trans *trans)
 	/* Backtrack one entry */
 	rxq->read = i;
 	if (fill_rx)
-		iwlagn_rx_replenish_now(trans);
+		iwlagn_rx_replenish_now(trans,
+					RX_QUEUE_SIZE + RX_FREE_BUFFERS);
+	else if (rxq->free_count <= RX_LOW_WATERMARK)
+		/*
+		 * Top up a few buffers right away rather than waiting for
+		 * the replenish work, the work is still scheduled by the
+		 * restock if that was not enough.
+		 */
+		iwlagn_rx_replenish_now(trans, RX_REPLENISH_BATCH);
 	else
 		iwlagn_rx_queue_restock(trans);
 }
@@ -75,3 +75,34 @@ int iwl_trans_send_cmd_pdu(struct iwl_trans *trans, u8 id,
 
 	return iwl_trans_send_cmd(trans, &cmd);
 }
+
+/*
+ * The uCode services the command queue strictly in order, so a batch
+ * is queued as asynchronous commands followed by a single synchronous
+ * one: once the last command completes every earlier one has been
+ * processed as well, and the caller sleeps only once for the batch.
+ *
+ * Only the last command may ask for the response (CMD_WANT_SKB); the
+ * status of the earlier commands is reported through their Rx handlers.
+ */
+int iwl_trans_send_cmd_batch(struct iwl_trans *trans,
+			     struct iwl_host_cmd *cmds, int num)
+{
+	int i, ret;
+
+	if (WARN_ON(num <= 0))
+		return -EINVAL;
+
+	for (i = 0; i < num - 1; i++) {
+		if (WARN_ON(cmds[i].flags & CMD_WANT_SKB))
+			return -EINVAL;
+
+		cmds[i].flags |= CMD_ASYNC;
+		ret = iwl_trans_send_cmd(trans, &cmds[i]);
+		if (ret)
+			return ret;
+	}
+
+	cmds[num - 1].flags &= ~CMD_ASYNC;
+	return iwl_trans_send_cmd(trans, &cmds[num - 1]);
+}
@@ -297,6 +297,9 @@ static inline int iwl_trans_send_cmd(struct iwl_trans *trans,
 int iwl_trans_send_cmd_pdu(struct iwl_trans *trans, u8 id,
 			   u32 flags, u16 len, const void *data);
 
+int iwl_trans_send_cmd_batch(struct iwl_trans *trans,
+			     struct iwl_host_cmd *cmds, int num);
+
 static inline int iwl_trans_tx(struct iwl_trans *trans, struct sk_buff *skb,
 		struct iwl_device_cmd *dev_cmd, enum iwl_rxon_context_id ctx,
 		u8 sta_id)
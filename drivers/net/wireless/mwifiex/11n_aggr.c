@@ -62,9 +62,8 @@ mwifiex_11n_form_amsdu_pkt(struct sk_buff *skb_aggr,
 	};
 	struct tx_packet_hdr *tx_header;
 
-	skb_put(skb_aggr, sizeof(*tx_header));
-
-	tx_header = (struct tx_packet_hdr *) skb_aggr->data;
+	tx_header = (struct tx_packet_hdr *) skb_put(skb_aggr,
+						     sizeof(*tx_header));
 
 	/* Copy DA and SA */
 	dt_offset = 2 * ETH_ALEN;
@@ -82,16 +81,99 @@ mwifiex_11n_form_amsdu_pkt(struct sk_buff *skb_aggr,
 	tx_header->eth803_hdr.h_proto = htons(skb_src->len + LLC_SNAP_LEN);
 
 	/* Add payload */
-	skb_put(skb_aggr, skb_src->len);
-	memcpy(skb_aggr->data + sizeof(*tx_header), skb_src->data,
-							skb_src->len);
+	memcpy(skb_put(skb_aggr, skb_src->len), skb_src->data, skb_src->len);
 	*pad = (((skb_src->len + LLC_SNAP_LEN) & 3)) ? (4 - (((skb_src->len +
 						      LLC_SNAP_LEN)) & 3)) : 0;
-	skb_put(skb_aggr, *pad);
 
 	return skb_aggr->len + *pad;
 }
 
+/*
+ * Turns an MSDU into an AMSDU subframe in place, for scatter-gather
+ * aggregation.
+ *
+ * The subframe header is written over the Ethernet header of the packet,
+ * using LLC_SNAP_LEN bytes of its headroom, so the payload is not copied.
+ * Tailroom for the padding returned in pad is made available as well.
+ * The packet is only reallocated if it is cloned or lacks that room.
+ */
+static int
+mwifiex_11n_form_amsdu_pkt_sg(struct sk_buff *skb_src, int *pad)
+{
+	struct rfc_1042_hdr snap = {
+		0xaa,		/* LLC DSAP */
+		0xaa,		/* LLC SSAP */
+		0x03,		/* LLC CTRL */
+		{0x00, 0x00, 0x00},	/* SNAP OUI */
+		0x0000		/* SNAP type */
+	};
+	struct tx_packet_hdr *tx_header;
+	u32 len = skb_src->len - sizeof(struct ethhdr) + LLC_SNAP_LEN;
+	int tail_pad = (len & 3) ? (4 - (len & 3)) : 0;
+
+	if (skb_cloned(skb_src) || skb_headroom(skb_src) < LLC_SNAP_LEN ||
+	    skb_tailroom(skb_src) < tail_pad) {
+		if (pskb_expand_head(skb_src, LLC_SNAP_LEN, tail_pad,
+				     GFP_ATOMIC))
+			return -ENOMEM;
+	}
+
+	snap.snap_type = ((struct ethhdr *) skb_src->data)->h_proto;
+
+	tx_header = (struct tx_packet_hdr *) skb_push(skb_src, LLC_SNAP_LEN);
+
+	/* Move DA and SA to the front of the subframe header */
+	memmove(&tx_header->eth803_hdr, skb_src->data + LLC_SNAP_LEN,
+		2 * ETH_ALEN);
+	tx_header->eth803_hdr.h_proto = htons(len);
+	memcpy(&tx_header->rfc1042_hdr, &snap, sizeof(struct rfc_1042_hdr));
+	*pad = tail_pad;
+
+	return 0;
+}
+
+/*
+ * Chains an AMSDU subframe to the frag_list of the AMSDU packet.
+ */
+static void
+mwifiex_11n_chain_amsdu_pkt(struct sk_buff *skb_aggr, struct sk_buff **tail,
+			    struct sk_buff *skb_src)
+{
+	if (*tail)
+		(*tail)->next = skb_src;
+	else
+		skb_shinfo(skb_aggr)->frag_list = skb_src;
+	*tail = skb_src;
+
+	skb_aggr->len += skb_src->len;
+	skb_aggr->data_len += skb_src->len;
+	skb_aggr->truesize += skb_src->truesize;
+}
+
+/*
+ * Adds padding to, or with a negative pad removes it from, the last
+ * subframe of an AMSDU packet.
+ */
+static void
+mwifiex_11n_pad_amsdu_pkt(struct sk_buff *skb_aggr, struct sk_buff *tail,
+			  int pad)
+{
+	if (!tail) {
+		if (pad > 0)
+			skb_put(skb_aggr, pad);
+		else
+			skb_trim(skb_aggr, skb_aggr->len + pad);
+		return;
+	}
+
+	if (pad > 0)
+		skb_put(tail, pad);
+	else
+		__skb_trim(tail, tail->len + pad);
+	skb_aggr->len += pad;
+	skb_aggr->data_len += pad;
+}
+
 /*
  * Adds TxPD to AMSDU header.
  *
@@ -150,6 +232,10 @@ mwifiex_11n_form_amsdu_txpd(struct mwifiex_private *priv,
  * |    TxPD   |AMSDU sub-frame|AMSDU sub-frame| .. |AMSDU sub-frame|
  * |           |       1       |       2       | .. |       n       |
  * +---- ~ ----+------ ~ ------+------ ~ ------+ .. +------ ~ ------+
+ *
+ * If the interface can gather it (tx_amsdu_sg), the subframes are built
+ * in place and chained to the frag_list of a packet holding only the
+ * TxPD, instead of being copied into one linear buffer.
  */
 int
 mwifiex_11n_aggregate_pkt(struct mwifiex_private *priv,
@@ -158,9 +244,12 @@ mwifiex_11n_aggregate_pkt(struct mwifiex_private *priv,
 			  __releases(&priv->wmm.ra_list_spinlock)
 {
 	struct mwifiex_adapter *adapter = priv->adapter;
-	struct sk_buff *skb_aggr, *skb_src;
+	struct sk_buff *skb_aggr, *skb_src, *skb_tail = NULL;
 	struct mwifiex_txinfo *tx_info_aggr, *tx_info_src;
 	int pad = 0, ret;
+	u32 aggr_size = adapter->tx_buf_size - headroom - sizeof(struct txpd);
+	u32 src_len;
+	bool sg = adapter->tx_amsdu_sg;
 	struct mwifiex_tx_param tx_param;
 	struct txpd *ptx_pd = NULL;
 
@@ -172,7 +261,8 @@ mwifiex_11n_aggregate_pkt(struct mwifiex_private *priv,
 	}
 
 	tx_info_src = MWIFIEX_SKB_TXCB(skb_src);
-	skb_aggr = dev_alloc_skb(adapter->tx_buf_size);
+	skb_aggr = dev_alloc_skb(sg ? headroom + sizeof(struct txpd) :
+				 adapter->tx_buf_size);
 	if (!skb_aggr) {
 		dev_err(adapter->dev, "%s: alloc skb_aggr\n", __func__);
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
@@ -187,34 +277,47 @@ mwifiex_11n_aggregate_pkt(struct mwifiex_private *priv,
 
 	do {
 		/* Check if AMSDU can accommodate this MSDU */
-		if (skb_tailroom(skb_aggr) < (skb_src->len + LLC_SNAP_LEN))
+		if (skb_aggr->len + skb_src->len + LLC_SNAP_LEN > aggr_size)
+			break;
+
+		/* the SG subframe header grows skb_src, account for it first */
+		src_len = skb_src->len;
+
+		if (sg && mwifiex_11n_form_amsdu_pkt_sg(skb_src, &pad))
 			break;
 
 		skb_src = skb_dequeue(&pra_list->skb_head);
 
-		pra_list->total_pkts_size -= skb_src->len;
+		pra_list->total_pkts_size -= src_len;
+		pra_list->total_pkts--;
 
 		atomic_dec(&priv->wmm.tx_pkts_queued);
+		atomic_dec(&priv->wmm.tid_pkts_queued[ptrindex]);
 
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
 				       ra_list_flags);
-		mwifiex_11n_form_amsdu_pkt(skb_aggr, skb_src, &pad);
-
-		mwifiex_write_data_complete(adapter, skb_src, 0);
+		if (sg) {
+			mwifiex_11n_chain_amsdu_pkt(skb_aggr, &skb_tail,
+						    skb_src);
+		} else {
+			mwifiex_11n_form_amsdu_pkt(skb_aggr, skb_src, &pad);
+			mwifiex_write_data_complete(adapter, skb_src, 0);
+		}
 
 		spin_lock_irqsave(&priv->wmm.ra_list_spinlock, ra_list_flags);
 
 		if (!mwifiex_is_ralist_valid(priv, pra_list, ptrindex)) {
 			spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
 					       ra_list_flags);
+			mwifiex_write_data_complete(adapter, skb_aggr, -1);
 			return -1;
 		}
 
-		if (skb_tailroom(skb_aggr) < pad) {
+		if (skb_aggr->len + pad > aggr_size) {
 			pad = 0;
 			break;
 		}
-		skb_put(skb_aggr, pad);
+		mwifiex_11n_pad_amsdu_pkt(skb_aggr, skb_tail, pad);
 
 		skb_src = skb_peek(&pra_list->skb_head);
 
@@ -222,8 +325,15 @@ mwifiex_11n_aggregate_pkt(struct mwifiex_private *priv,
 
 	spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock, ra_list_flags);
 
+	if (!skb_aggr->len) {
+		dev_err(adapter->dev, "%s: no room for AMSDU subframe\n",
+			__func__);
+		dev_kfree_skb_any(skb_aggr);
+		return -1;
+	}
+
 	/* Last AMSDU packet does not need padding */
-	skb_trim(skb_aggr, skb_aggr->len - pad);
+	mwifiex_11n_pad_amsdu_pkt(skb_aggr, skb_tail, -pad);
 
 	/* Form AMSDU */
 	mwifiex_11n_form_amsdu_txpd(priv, skb_aggr);
@@ -267,8 +377,10 @@ mwifiex_11n_aggregate_pkt(struct mwifiex_private *priv,
 		skb_queue_tail(&pra_list->skb_head, skb_aggr);
 
 		pra_list->total_pkts_size += skb_aggr->len;
+		pra_list->total_pkts++;
 
 		atomic_inc(&priv->wmm.tx_pkts_queued);
+		atomic_inc(&priv->wmm.tid_pkts_queued[ptrindex]);
 
 		tx_info_aggr->flags |= MWIFIEX_BUF_FLAG_REQUEUED_PKT;
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
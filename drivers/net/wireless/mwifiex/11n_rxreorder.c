@@ -26,12 +26,48 @@
 #include "11n.h"
 #include "11n_rxreorder.h"
 
+/*
+ * This function sends a list of packets released from an Rx reorder
+ * table to the kernel, in order.
+ */
+static void
+mwifiex_11n_dispatch_pkt_list(struct mwifiex_private *priv,
+			      struct sk_buff_head *list)
+{
+	struct sk_buff *skb;
+
+	while ((skb = __skb_dequeue(list)))
+		mwifiex_process_rx_packet(priv->adapter, skb);
+}
+
+/*
+ * This function moves the Rx reorder window forward by the given number
+ * of slots.
+ *
+ * We don't have a circular buffer, hence use rotation to simulate
+ * circular buffer. The slots being shifted out must already be empty.
+ */
+static void
+mwifiex_11n_rotate_reorder_ptr(struct mwifiex_rx_reorder_tbl *rx_reor_tbl_ptr,
+			       int shift)
+{
+	int keep = rx_reor_tbl_ptr->win_size - shift;
+
+	if (shift <= 0)
+		return;
+
+	memmove(&rx_reor_tbl_ptr->rx_reorder_ptr[0],
+		&rx_reor_tbl_ptr->rx_reorder_ptr[shift], keep * sizeof(void *));
+	memset(&rx_reor_tbl_ptr->rx_reorder_ptr[keep], 0,
+	       shift * sizeof(void *));
+}
+
 /*
  * This function dispatches all packets in the Rx reorder table.
  *
  * There could be holes in the buffer, which are skipped by the function.
- * Since the buffer is linear, the function uses rotation to simulate
- * circular buffer.
+ * The packets are collected under a single hold of the Rx packet lock
+ * and then dispatched as one list.
  */
 static void
 mwifiex_11n_dispatch_pkt_until_start_win(struct mwifiex_private *priv,
@@ -39,38 +75,30 @@ mwifiex_11n_dispatch_pkt_until_start_win(struct mwifiex_private *priv,
 					 *rx_reor_tbl_ptr, int start_win)
 {
 	int no_pkt_to_send, i;
-	void *rx_tmp_ptr;
+	struct sk_buff_head list;
 	unsigned long flags;
 
 	no_pkt_to_send = (start_win > rx_reor_tbl_ptr->start_win) ?
 		min((start_win - rx_reor_tbl_ptr->start_win),
 		    rx_reor_tbl_ptr->win_size) : rx_reor_tbl_ptr->win_size;
 
+	__skb_queue_head_init(&list);
+
+	spin_lock_irqsave(&priv->rx_pkt_lock, flags);
 	for (i = 0; i < no_pkt_to_send; ++i) {
-		spin_lock_irqsave(&priv->rx_pkt_lock, flags);
-		rx_tmp_ptr = NULL;
 		if (rx_reor_tbl_ptr->rx_reorder_ptr[i]) {
-			rx_tmp_ptr = rx_reor_tbl_ptr->rx_reorder_ptr[i];
+			__skb_queue_tail(&list,
+					 rx_reor_tbl_ptr->rx_reorder_ptr[i]);
 			rx_reor_tbl_ptr->rx_reorder_ptr[i] = NULL;
 		}
-		spin_unlock_irqrestore(&priv->rx_pkt_lock, flags);
-		if (rx_tmp_ptr)
-			mwifiex_process_rx_packet(priv->adapter, rx_tmp_ptr);
 	}
 
-	spin_lock_irqsave(&priv->rx_pkt_lock, flags);
-	/*
-	 * We don't have a circular buffer, hence use rotation to simulate
-	 * circular buffer
-	 */
-	for (i = 0; i < rx_reor_tbl_ptr->win_size - no_pkt_to_send; ++i) {
-		rx_reor_tbl_ptr->rx_reorder_ptr[i] =
-			rx_reor_tbl_ptr->rx_reorder_ptr[no_pkt_to_send + i];
-		rx_reor_tbl_ptr->rx_reorder_ptr[no_pkt_to_send + i] = NULL;
-	}
+	mwifiex_11n_rotate_reorder_ptr(rx_reor_tbl_ptr, no_pkt_to_send);
 
 	rx_reor_tbl_ptr->start_win = start_win;
 	spin_unlock_irqrestore(&priv->rx_pkt_lock, flags);
+
+	mwifiex_11n_dispatch_pkt_list(priv, &list);
 }
 
 /*
@@ -78,45 +106,34 @@ mwifiex_11n_dispatch_pkt_until_start_win(struct mwifiex_private *priv,
  * a hole is found.
  *
  * The start window is adjusted automatically when a hole is located.
- * Since the buffer is linear, the function uses rotation to simulate
- * circular buffer.
+ * The packets are collected under a single hold of the Rx packet lock
+ * and then dispatched as one list.
  */
 static void
 mwifiex_11n_scan_and_dispatch(struct mwifiex_private *priv,
 			      struct mwifiex_rx_reorder_tbl *rx_reor_tbl_ptr)
 {
-	int i, j, xchg;
-	void *rx_tmp_ptr;
+	int i;
+	struct sk_buff_head list;
 	unsigned long flags;
 
+	__skb_queue_head_init(&list);
+
+	spin_lock_irqsave(&priv->rx_pkt_lock, flags);
 	for (i = 0; i < rx_reor_tbl_ptr->win_size; ++i) {
-		spin_lock_irqsave(&priv->rx_pkt_lock, flags);
-		if (!rx_reor_tbl_ptr->rx_reorder_ptr[i]) {
-			spin_unlock_irqrestore(&priv->rx_pkt_lock, flags);
+		if (!rx_reor_tbl_ptr->rx_reorder_ptr[i])
 			break;
-		}
-		rx_tmp_ptr = rx_reor_tbl_ptr->rx_reorder_ptr[i];
+		__skb_queue_tail(&list, rx_reor_tbl_ptr->rx_reorder_ptr[i]);
 		rx_reor_tbl_ptr->rx_reorder_ptr[i] = NULL;
-		spin_unlock_irqrestore(&priv->rx_pkt_lock, flags);
-		mwifiex_process_rx_packet(priv->adapter, rx_tmp_ptr);
 	}
 
-	spin_lock_irqsave(&priv->rx_pkt_lock, flags);
-	/*
-	 * We don't have a circular buffer, hence use rotation to simulate
-	 * circular buffer
-	 */
-	if (i > 0) {
-		xchg = rx_reor_tbl_ptr->win_size - i;
-		for (j = 0; j < xchg; ++j) {
-			rx_reor_tbl_ptr->rx_reorder_ptr[j] =
-				rx_reor_tbl_ptr->rx_reorder_ptr[i + j];
-			rx_reor_tbl_ptr->rx_reorder_ptr[i + j] = NULL;
-		}
-	}
+	mwifiex_11n_rotate_reorder_ptr(rx_reor_tbl_ptr, i);
+
 	rx_reor_tbl_ptr->start_win = (rx_reor_tbl_ptr->start_win + i)
 		&(MAX_TID_VALUE - 1);
 	spin_unlock_irqrestore(&priv->rx_pkt_lock, flags);
+
+	mwifiex_11n_dispatch_pkt_list(priv, &list);
 }
 
 /*
@@ -144,6 +161,7 @@ mwifiex_11n_delete_rx_reorder_tbl_entry(struct mwifiex_private *priv,
 
 	spin_lock_irqsave(&priv->rx_reorder_tbl_lock, flags);
 	list_del(&rx_reor_tbl_ptr->list);
+	list_del(&rx_reor_tbl_ptr->tid_list);
 	spin_unlock_irqrestore(&priv->rx_reorder_tbl_lock, flags);
 
 	kfree(rx_reor_tbl_ptr->rx_reorder_ptr);
@@ -153,6 +171,9 @@ mwifiex_11n_delete_rx_reorder_tbl_entry(struct mwifiex_private *priv,
 /*
  * This function returns the pointer to an entry in Rx reordering
  * table which matches the given TA/TID pair.
+ *
+ * Entries are looked up in the list of the TID, which only holds one
+ * entry per TA.
  */
 static struct mwifiex_rx_reorder_tbl *
 mwifiex_11n_get_rx_reorder_tbl(struct mwifiex_private *priv, int tid, u8 *ta)
@@ -160,10 +181,13 @@ mwifiex_11n_get_rx_reorder_tbl(struct mwifiex_private *priv, int tid, u8 *ta)
 	struct mwifiex_rx_reorder_tbl *rx_reor_tbl_ptr;
 	unsigned long flags;
 
+	if (tid < 0 || tid >= MAX_NUM_TID)
+		return NULL;
+
 	spin_lock_irqsave(&priv->rx_reorder_tbl_lock, flags);
-	list_for_each_entry(rx_reor_tbl_ptr, &priv->rx_reorder_tbl_ptr, list) {
-		if ((!memcmp(rx_reor_tbl_ptr->ta, ta, ETH_ALEN))
-		    && (rx_reor_tbl_ptr->tid == tid)) {
+	list_for_each_entry(rx_reor_tbl_ptr, &priv->rx_reorder_tid_tbl[tid],
+			    tid_list) {
+		if (!memcmp(rx_reor_tbl_ptr->ta, ta, ETH_ALEN)) {
 			spin_unlock_irqrestore(&priv->rx_reorder_tbl_lock,
 					       flags);
 			return rx_reor_tbl_ptr;
@@ -244,6 +268,13 @@ mwifiex_11n_create_rx_reorder_tbl(struct mwifiex_private *priv, u8 *ta,
 							 seq_num);
 		return;
 	}
+
+	if (tid < 0 || tid >= MAX_NUM_TID) {
+		dev_err(priv->adapter->dev, "%s: invalid tid %d\n",
+			__func__, tid);
+		return;
+	}
+
 	/* if !rx_reor_tbl_ptr then create one */
 	new_node = kzalloc(sizeof(struct mwifiex_rx_reorder_tbl), GFP_KERNEL);
 	if (!new_node) {
@@ -253,6 +284,7 @@ mwifiex_11n_create_rx_reorder_tbl(struct mwifiex_private *priv, u8 *ta,
 	}
 
 	INIT_LIST_HEAD(&new_node->list);
+	INIT_LIST_HEAD(&new_node->tid_list);
 	new_node->tid = tid;
 	memcpy(new_node->ta, ta, ETH_ALEN);
 	new_node->start_win = seq_num;
@@ -291,6 +323,7 @@ mwifiex_11n_create_rx_reorder_tbl(struct mwifiex_private *priv, u8 *ta,
 
 	spin_lock_irqsave(&priv->rx_reorder_tbl_lock, flags);
 	list_add_tail(&new_node->list, &priv->rx_reorder_tbl_ptr);
+	list_add_tail(&new_node->tid_list, &priv->rx_reorder_tid_tbl[tid]);
 	spin_unlock_irqrestore(&priv->rx_reorder_tbl_lock, flags);
 }
 
@@ -594,6 +627,7 @@ void mwifiex_11n_cleanup_reorder_tbl(struct mwifiex_private *priv)
 {
 	struct mwifiex_rx_reorder_tbl *del_tbl_ptr, *tmp_node;
 	unsigned long flags;
+	int i;
 
 	spin_lock_irqsave(&priv->rx_reorder_tbl_lock, flags);
 	list_for_each_entry_safe(del_tbl_ptr, tmp_node,
@@ -605,5 +639,7 @@ void mwifiex_11n_cleanup_reorder_tbl(struct mwifiex_private *priv)
 	spin_unlock_irqrestore(&priv->rx_reorder_tbl_lock, flags);
 
 	INIT_LIST_HEAD(&priv->rx_reorder_tbl_ptr);
+	for (i = 0; i < MAX_NUM_TID; ++i)
+		INIT_LIST_HEAD(&priv->rx_reorder_tid_tbl[i]);
 	memset(priv->rx_seq, 0, sizeof(priv->rx_seq));
 }
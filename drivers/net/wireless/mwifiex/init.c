@@ -392,6 +392,7 @@ int mwifiex_init_lock_list(struct mwifiex_adapter *adapter)
 		for (j = 0; j < MAX_NUM_TID; ++j) {
 			INIT_LIST_HEAD(&priv->wmm.tid_tbl_ptr[j].ra_list);
 			spin_lock_init(&priv->wmm.tid_tbl_ptr[j].tid_tbl_lock);
+			INIT_LIST_HEAD(&priv->rx_reorder_tid_tbl[j]);
 		}
 		INIT_LIST_HEAD(&priv->tx_ba_stream_tbl_ptr);
 		INIT_LIST_HEAD(&priv->rx_reorder_tbl_ptr);
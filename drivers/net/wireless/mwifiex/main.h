@@ -181,6 +181,8 @@ struct mwifiex_ra_list_tbl {
 	struct sk_buff_head skb_head;
 	u8 ra[ETH_ALEN];
 	u32 total_pkts_size;
+	/* Number of packets on skb_head */
+	u32 total_pkts;
 	u32 is_11n_enabled;
 };
 
@@ -208,6 +210,8 @@ struct mwifiex_wmm_desc {
 	u32 user_pri_pkt_tx_ctrl[WMM_HIGHEST_PRIORITY + 1];	/* UP: 0 to 7 */
 	/* Number of transmit packets queued */
 	atomic_t tx_pkts_queued;
+	/* Number of transmit packets queued per TID */
+	atomic_t tid_pkts_queued[MAX_NUM_TID];
 	/* Tracks highest priority with a packet queued */
 	atomic_t highest_queued_prio;
 };
@@ -417,6 +421,8 @@ struct mwifiex_private {
 	struct mwifiex_add_ba_param add_ba_param;
 	u16 rx_seq[MAX_NUM_TID];
 	struct list_head rx_reorder_tbl_ptr;
+	/* Rx reorder table entries of each TID, one per TA */
+	struct list_head rx_reorder_tid_tbl[MAX_NUM_TID];
 	/* spin lock for rx_reorder_tbl_ptr queue */
 	spinlock_t rx_reorder_tbl_lock;
 	/* spin lock for Rx packets */
@@ -490,6 +496,7 @@ struct reorder_tmr_cnxt {
 
 struct mwifiex_rx_reorder_tbl {
 	struct list_head list;
+	struct list_head tid_list;
 	int tid;
 	u8 ta[ETH_ALEN];
 	int start_win;
@@ -573,6 +580,8 @@ struct mwifiex_adapter {
 	u16 max_tx_buf_size;
 	u16 tx_buf_size;
 	u16 curr_tx_buf_size;
+	/* Interface can send AMSDU subframes chained on skb frag_list */
+	bool tx_amsdu_sg;
 	u32 ioport;
 	enum MWIFIEX_HARDWARE_STATUS hw_status;
 	u16 number_of_antenna;
@@ -775,7 +775,8 @@ mwifiex_pcie_send_data(struct mwifiex_adapter *adapter, struct sk_buff *skb)
 
 		adapter->data_sent = true;
 		skb_data = card->tx_buf_list[wrindx];
-		memcpy(skb_data->data, skb->data, skb->len);
+		/* Gathers the subframes of a scatter-gather AMSDU packet */
+		skb_copy_bits(skb, 0, skb_data->data, skb->len);
 		payload = skb_data->data;
 		tmp = (__le16 *)&payload[0];
 		*tmp = cpu_to_le16((u16)skb->len);
@@ -1853,6 +1854,7 @@ static int mwifiex_register_dev(struct mwifiex_adapter *adapter)
 
 	adapter->dev = &pdev->dev;
 	strcpy(adapter->fw_name, PCIE8766_DEFAULT_FW_NAME);
+	adapter->tx_amsdu_sg = true;
 
 	return 0;
 }
@@ -124,11 +124,30 @@ int mwifiex_write_data_complete(struct mwifiex_adapter *adapter,
 {
 	struct mwifiex_private *priv, *tpriv;
 	struct mwifiex_txinfo *tx_info;
+	struct sk_buff *frag, *next;
 	int i;
 
 	if (!skb)
 		return 0;
 
+	/*
+	 * MSDUs chained to a scatter-gather AMSDU packet complete with it.
+	 * Unchain them first so that each one is accounted and freed on
+	 * its own.
+	 */
+	if (skb_has_frag_list(skb)) {
+		frag = skb_shinfo(skb)->frag_list;
+		skb_shinfo(skb)->frag_list = NULL;
+		skb->len -= skb->data_len;
+		skb->data_len = 0;
+		while (frag) {
+			next = frag->next;
+			frag->next = NULL;
+			mwifiex_write_data_complete(adapter, frag, status);
+			frag = next;
+		}
+	}
+
 	tx_info = MWIFIEX_SKB_TXCB(skb);
 	priv = mwifiex_bss_index_to_priv(adapter, tx_info->bss_index);
 	if (!priv)
@@ -121,6 +121,7 @@ mwifiex_wmm_allocate_ralist_node(struct mwifiex_adapter *adapter, u8 *ra)
 	memcpy(ra_list->ra, ra, ETH_ALEN);
 
 	ra_list->total_pkts_size = 0;
+	ra_list->total_pkts = 0;
 
 	dev_dbg(adapter->dev, "info: allocated ra_list %p\n", ra_list);
 
@@ -408,6 +409,8 @@ mwifiex_wmm_init(struct mwifiex_adapter *adapter)
 
 		atomic_set(&priv->wmm.tx_pkts_queued, 0);
 		atomic_set(&priv->wmm.highest_queued_prio, HIGH_PRIO_TID);
+		for (i = 0; i < MAX_NUM_TID; ++i)
+			atomic_set(&priv->wmm.tid_pkts_queued[i], 0);
 	}
 }
 
@@ -470,9 +473,11 @@ static void mwifiex_wmm_cleanup_queues(struct mwifiex_private *priv)
 {
 	int i;
 
-	for (i = 0; i < MAX_NUM_TID; i++)
+	for (i = 0; i < MAX_NUM_TID; i++) {
 		mwifiex_wmm_del_pkts_in_ralist(priv, &priv->wmm.tid_tbl_ptr[i].
 						     ra_list);
+		atomic_set(&priv->wmm.tid_pkts_queued[i], 0);
+	}
 
 	atomic_set(&priv->wmm.tx_pkts_queued, 0);
 	atomic_set(&priv->wmm.highest_queued_prio, HIGH_PRIO_TID);
@@ -647,8 +652,10 @@ mwifiex_wmm_add_buf_txqueue(struct mwifiex_adapter *adapter,
 	skb_queue_tail(&ra_list->skb_head, skb);
 
 	ra_list->total_pkts_size += skb->len;
+	ra_list->total_pkts++;
 
 	atomic_inc(&priv->wmm.tx_pkts_queued);
+	atomic_inc(&priv->wmm.tid_pkts_queued[tid_down]);
 
 	if (atomic_read(&priv->wmm.highest_queued_prio) <
 						tos_to_tid_inv[tid_down])
@@ -842,6 +849,10 @@ mwifiex_wmm_compute_drv_pkt_delay(struct mwifiex_private *priv,
 
 /*
  * This function retrieves the highest priority RA list table pointer.
+ *
+ * The selection is still a walk over BSS priorities, TIDs and RA lists;
+ * the per-TID queued packet counters only let it skip empty TIDs without
+ * walking their RA lists.
  */
 static struct mwifiex_ra_list_tbl *
 mwifiex_wmm_get_highest_priolist_ptr(struct mwifiex_adapter *adapter,
@@ -892,14 +903,12 @@ mwifiex_wmm_get_highest_priolist_ptr(struct mwifiex_adapter *adapter,
 				tid_ptr = &(priv_tmp)->wmm.
 					tid_tbl_ptr[tos_to_tid[i]];
 
-				spin_lock_irqsave(&tid_ptr->tid_tbl_lock,
-						  flags);
-				is_list_empty =
-					list_empty(&adapter->bss_prio_tbl[j]
-						   .bss_prio_head);
-				spin_unlock_irqrestore(&tid_ptr->tid_tbl_lock,
-						       flags);
-				if (is_list_empty)
+				/*
+				 * Skip TIDs with nothing queued without
+				 * walking their RA lists.
+				 */
+				if (!atomic_read(&priv_tmp->wmm.
+						 tid_pkts_queued[tos_to_tid[i]]))
 					continue;
 
 				/*
@@ -983,6 +992,9 @@ mwifiex_is_11n_aggragation_possible(struct mwifiex_private *priv,
 	int count = 0, total_size = 0;
 	struct sk_buff *skb, *tmp;
 
+	if (ptr->total_pkts < MIN_NUM_AMSDU)
+		return false;
+
 	skb_queue_walk_safe(&ptr->skb_head, skb, tmp) {
 		total_size += skb->len;
 		if (total_size >= max_buf_size)
@@ -1021,6 +1033,7 @@ mwifiex_send_single_packet(struct mwifiex_private *priv,
 	dev_dbg(adapter->dev, "data: dequeuing the packet %p %p\n", ptr, skb);
 
 	ptr->total_pkts_size -= skb->len;
+	ptr->total_pkts--;
 
 	if (!skb_queue_empty(&ptr->skb_head))
 		skb_next = skb_peek(&ptr->skb_head);
@@ -1046,6 +1059,7 @@ mwifiex_send_single_packet(struct mwifiex_private *priv,
 		skb_queue_tail(&ptr->skb_head, skb);
 
 		ptr->total_pkts_size += skb->len;
+		ptr->total_pkts++;
 		tx_info->flags |= MWIFIEX_BUF_FLAG_REQUEUED_PKT;
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
 				       ra_list_flags);
@@ -1062,6 +1076,7 @@ mwifiex_send_single_packet(struct mwifiex_private *priv,
 				struct mwifiex_bss_prio_node,
 				list);
 		atomic_dec(&priv->wmm.tx_pkts_queued);
+		atomic_dec(&priv->wmm.tid_pkts_queued[ptr_index]);
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
 				       ra_list_flags);
 	}
@@ -1113,6 +1128,7 @@ mwifiex_send_processed_packet(struct mwifiex_private *priv,
 	}
 
 	skb = skb_dequeue(&ptr->skb_head);
+	ptr->total_pkts--;
 
 	if (!skb_queue_empty(&ptr->skb_head))
 		skb_next = skb_peek(&ptr->skb_head);
@@ -1140,6 +1156,7 @@ mwifiex_send_processed_packet(struct mwifiex_private *priv,
 		}
 
 		skb_queue_tail(&ptr->skb_head, skb);
+		ptr->total_pkts++;
 
 		tx_info->flags |= MWIFIEX_BUF_FLAG_REQUEUED_PKT;
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
@@ -1169,6 +1186,7 @@ mwifiex_send_processed_packet(struct mwifiex_private *priv,
 				struct mwifiex_bss_prio_node,
 				list);
 		atomic_dec(&priv->wmm.tx_pkts_queued);
+		atomic_dec(&priv->wmm.tid_pkts_queued[ptr_index]);
 		spin_unlock_irqrestore(&priv->wmm.ra_list_spinlock,
 				       ra_list_flags);
 	}
@@ -900,6 +900,11 @@
 #define TX_PWR_CFG_RATE6		FIELD32(0x0f000000)
 #define TX_PWR_CFG_RATE7		FIELD32(0xf0000000)
 
+/*
+ * Number of consecutive TX_PWR_CFG registers (TX_PWR_CFG_0 - TX_PWR_CFG_4)
+ */
+#define TX_PWR_CFG_NUM			5
+
 /*
  * TX_PWR_CFG_0:
  */
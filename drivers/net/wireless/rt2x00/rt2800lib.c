@@ -2267,7 +2267,8 @@ static void rt2800_config_txpower(struct rt2x00_dev *rt2x00dev,
 	int i, is_rate_b;
 	u32 reg;
 	u8 r1;
-	u32 offset;
+	__le32 pwr_cfg[TX_PWR_CFG_NUM];
+	unsigned int idx;
 	int delta;
 
 	/*
@@ -2286,14 +2287,33 @@ static void rt2800_config_txpower(struct rt2x00_dev *rt2x00dev,
 	rt2800_bbp_read(rt2x00dev, 1, &r1);
 	rt2x00_set_field8(&r1, BBP1_TX_POWER_CTRL, 0);
 	rt2800_bbp_write(rt2x00dev, 1, r1);
-	offset = TX_PWR_CFG_0;
+
+	/*
+	 * The TX_PWR_CFG registers are consecutive. On USB read and write
+	 * them as a single block, which saves a control transfer per
+	 * register on every channel change and every gain calibration
+	 * from the link tuner. The PCI block helpers are memcpy_fromio and
+	 * memcpy_toio, which may access the registers bytewise, so PCI
+	 * keeps 32-bit accesses.
+	 */
+	if (rt2x00_is_usb(rt2x00dev)) {
+		rt2800_register_multiread(rt2x00dev, TX_PWR_CFG_0,
+					  pwr_cfg, sizeof(pwr_cfg));
+	} else {
+		for (idx = 0; idx < TX_PWR_CFG_NUM; idx++) {
+			rt2800_register_read(rt2x00dev, TX_PWR_CFG_0 + idx * 4,
+					     &reg);
+			pwr_cfg[idx] = cpu_to_le32(reg);
+		}
+	}
+	idx = 0;
 
 	for (i = 0; i < EEPROM_TXPOWER_BYRATE_SIZE; i += 2) {
 		/* just to be safe */
-		if (offset > TX_PWR_CFG_4)
+		if (idx >= TX_PWR_CFG_NUM)
 			break;
 
-		rt2800_register_read(rt2x00dev, offset, &reg);
+		reg = le32_to_cpu(pwr_cfg[idx]);
 
 		/* read the next four txpower values */
 		rt2x00_eeprom_read(rt2x00dev, EEPROM_TXPOWER_BYRATE + i,
@@ -2393,10 +2413,19 @@ static void rt2800_config_txpower(struct rt2x00_dev *rt2x00dev,
 					     power_level, txpower, delta);
 		rt2x00_set_field32(&reg, TX_PWR_CFG_RATE7, txpower);
 
-		rt2800_register_write(rt2x00dev, offset, reg);
+		pwr_cfg[idx] = cpu_to_le32(reg);
 
 		/* next TX_PWR_CFG register */
-		offset += 4;
+		idx++;
+	}
+
+	if (rt2x00_is_usb(rt2x00dev)) {
+		rt2800_register_multiwrite(rt2x00dev, TX_PWR_CFG_0,
+					   pwr_cfg, sizeof(pwr_cfg));
+	} else {
+		for (idx = 0; idx < TX_PWR_CFG_NUM; idx++)
+			rt2800_register_write(rt2x00dev, TX_PWR_CFG_0 + idx * 4,
+					      le32_to_cpu(pwr_cfg[idx]));
 	}
 }
 
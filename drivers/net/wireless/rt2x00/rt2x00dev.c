@@ -585,7 +585,9 @@ void rt2x00lib_rxdone(struct queue_entry *entry)
 	struct rxdone_entry_desc rxdesc;
 	struct sk_buff *skb;
 	struct ieee80211_rx_status *rx_status;
+	unsigned char *rx_data;
 	unsigned int header_length;
+	bool recycle = true;
 	int rate_idx;
 
 	if (!test_bit(DEVICE_STATE_PRESENT, &rt2x00dev->flags) ||
@@ -596,17 +598,16 @@ void rt2x00lib_rxdone(struct queue_entry *entry)
 		goto submit_entry;
 
 	/*
-	 * Allocate a new sk_buffer. If no new buffer available, drop the
-	 * received frame and reuse the existing buffer.
+	 * Remember where the buffer starts, parsing the descriptor
+	 * might pull data from the skb.
 	 */
-	skb = rt2x00queue_alloc_rxskb(entry);
-	if (!skb)
-		goto submit_entry;
+	rx_data = entry->skb->data;
 
 	/*
-	 * Unmap the skb.
+	 * Make the descriptor and the start of the frame visible to the
+	 * CPU. The buffer is only unmapped if it is passed to mac80211.
 	 */
-	rt2x00queue_unmap_skb(entry);
+	rt2x00queue_sync_rxskb_for_cpu(entry);
 
 	/*
 	 * Extract the RXD details.
@@ -622,15 +623,42 @@ void rt2x00lib_rxdone(struct queue_entry *entry)
 		     rxdesc.size > entry->queue->data_size)) {
 		WARNING(rt2x00dev, "Wrong frame size %d max %d.\n",
 			rxdesc.size, entry->queue->data_size);
-		dev_kfree_skb(entry->skb);
-		goto renew_skb;
+		goto recycle_skb;
+	}
+
+	/*
+	 * Small frames are copied, which allows the RX buffer to be given
+	 * back to the hardware without unmapping and reallocating it.
+	 * The copy includes room for the L2 padding.
+	 */
+	if (rxdesc.size <= RX_COPYBREAK &&
+	    (entry->skb->data - rx_data) + rxdesc.size + 3 <= RX_SYNC_SIZE) {
+		skb = rt2x00queue_copy_rxskb(entry, rxdesc.size + 3);
+		if (!skb)
+			goto recycle_skb;
+	} else {
+		/*
+		 * Allocate a new sk_buffer. If no new buffer available, drop
+		 * the received frame and reuse the existing buffer.
+		 */
+		skb = rt2x00queue_alloc_rxskb(entry);
+		if (!skb)
+			goto recycle_skb;
+
+		/*
+		 * Unmap the skb and replace it with the freshly
+		 * allocated one.
+		 */
+		rt2x00queue_unmap_skb(entry);
+		swap(skb, entry->skb);
+		recycle = false;
 	}
 
 	/*
 	 * The data behind the ieee80211 header must be
 	 * aligned on a 4 byte boundary.
 	 */
-	header_length = ieee80211_get_hdrlen_from_skb(entry->skb);
+	header_length = ieee80211_get_hdrlen_from_skb(skb);
 
 	/*
 	 * Hardware might have stripped the IV/EIV/ICV data,
@@ -640,15 +668,15 @@ void rt2x00lib_rxdone(struct queue_entry *entry)
 	 */
 	if ((rxdesc.dev_flags & RXDONE_CRYPTO_IV) &&
 	    (rxdesc.flags & RX_FLAG_IV_STRIPPED))
-		rt2x00crypto_rx_insert_iv(entry->skb, header_length,
+		rt2x00crypto_rx_insert_iv(skb, header_length,
 					  &rxdesc);
 	else if (header_length &&
 		 (rxdesc.size > header_length) &&
 		 (rxdesc.dev_flags & RXDONE_L2PAD))
-		rt2x00queue_remove_l2pad(entry->skb, header_length);
+		rt2x00queue_remove_l2pad(skb, header_length);
 
 	/* Trim buffer to correct size */
-	skb_trim(entry->skb, rxdesc.size);
+	skb_trim(skb, rxdesc.size);
 
 	/*
 	 * Translate the signal to the correct bitrate index.
@@ -662,20 +690,20 @@ void rt2x00lib_rxdone(struct queue_entry *entry)
 	 * Check if this is a beacon, and more frames have been
 	 * buffered while we were in powersaving mode.
 	 */
-	rt2x00lib_rxdone_check_ps(rt2x00dev, entry->skb, &rxdesc);
+	rt2x00lib_rxdone_check_ps(rt2x00dev, skb, &rxdesc);
 
 	/*
 	 * Update extra components
 	 */
-	rt2x00link_update_stats(rt2x00dev, entry->skb, &rxdesc);
+	rt2x00link_update_stats(rt2x00dev, skb, &rxdesc);
 	rt2x00debug_update_crypto(rt2x00dev, &rxdesc);
-	rt2x00debug_dump_frame(rt2x00dev, DUMP_FRAME_RXDONE, entry->skb);
+	rt2x00debug_dump_frame(rt2x00dev, DUMP_FRAME_RXDONE, skb);
 
 	/*
 	 * Initialize RX status information, and send frame
 	 * to mac80211.
 	 */
-	rx_status = IEEE80211_SKB_RXCB(entry->skb);
+	rx_status = IEEE80211_SKB_RXCB(skb);
 	rx_status->mactime = rxdesc.timestamp;
 	rx_status->band = rt2x00dev->curr_band;
 	rx_status->freq = rt2x00dev->curr_freq;
@@ -684,13 +712,14 @@ void rt2x00lib_rxdone(struct queue_entry *entry)
 	rx_status->flag = rxdesc.flags;
 	rx_status->antenna = rt2x00dev->link.ant.active.rx;
 
-	ieee80211_rx_ni(rt2x00dev->hw, entry->skb);
+	ieee80211_rx_ni(rt2x00dev->hw, skb);
 
-renew_skb:
+recycle_skb:
 	/*
-	 * Replace the skb with the freshly allocated one.
+	 * The RX buffer is kept when the frame was copied or dropped.
 	 */
-	entry->skb = skb;
+	if (recycle)
+		rt2x00queue_recycle_rxskb(entry, rx_data);
 
 submit_entry:
 	entry->flags = 0;
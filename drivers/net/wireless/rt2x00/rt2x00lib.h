@@ -104,6 +104,36 @@ void rt2x00lib_config(struct rt2x00_dev *rt2x00dev,
  */
 struct sk_buff *rt2x00queue_alloc_rxskb(struct queue_entry *entry);
 
+/**
+ * rt2x00queue_sync_rxskb_for_cpu - Make the start of a RX buffer accessible
+ * @entry: The entry which contains the received frame.
+ *
+ * Only the first %RX_SYNC_SIZE bytes are synced, frames which are passed
+ * up as they are must be unmapped with rt2x00queue_unmap_skb().
+ */
+void rt2x00queue_sync_rxskb_for_cpu(struct queue_entry *entry);
+
+/**
+ * rt2x00queue_copy_rxskb - Copy a received frame into a new skb.
+ * @entry: The entry which contains the received frame.
+ * @length: Number of bytes to copy starting at the current data pointer.
+ *
+ * The copy uses the same 4-byte alignment as the original buffer so the
+ * L2 padding and IV handling work on it unchanged.
+ */
+struct sk_buff *rt2x00queue_copy_rxskb(struct queue_entry *entry,
+				       unsigned int length);
+
+/**
+ * rt2x00queue_recycle_rxskb - Prepare a RX buffer for reuse.
+ * @entry: The entry which contains the RX buffer.
+ * @data: Start of the buffer as it was handed to the hardware.
+ *
+ * Restores the skb layout after the frame was parsed and gives the
+ * buffer back to the device.
+ */
+void rt2x00queue_recycle_rxskb(struct queue_entry *entry, unsigned char *data);
+
 /**
  * rt2x00queue_free_skb - free a skb
  * @entry: The entry for which the skb will be applicable.
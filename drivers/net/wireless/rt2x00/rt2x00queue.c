@@ -97,6 +97,84 @@ struct sk_buff *rt2x00queue_alloc_rxskb(struct queue_entry *entry)
 	return skb;
 }
 
+void rt2x00queue_sync_rxskb_for_cpu(struct queue_entry *entry)
+{
+	struct device *dev = entry->queue->rt2x00dev->dev;
+	struct skb_frame_desc *skbdesc = get_skb_frame_desc(entry->skb);
+
+	if (!(skbdesc->flags & SKBDESC_DMA_MAPPED_RX))
+		return;
+
+	dma_sync_single_for_cpu(dev, skbdesc->skb_dma,
+				min_t(unsigned int, entry->skb->len,
+				      RX_SYNC_SIZE),
+				DMA_FROM_DEVICE);
+}
+
+struct sk_buff *rt2x00queue_copy_rxskb(struct queue_entry *entry,
+				       unsigned int length)
+{
+	struct sk_buff *skb = entry->skb;
+	struct sk_buff *nskb;
+	unsigned int head_size = 4;
+	unsigned int tail_size = 0;
+
+	/*
+	 * Keep room for IV/EIV/ICV assembly, see rt2x00queue_alloc_rxskb().
+	 */
+	if (test_bit(CAPABILITY_HW_CRYPTO,
+		     &entry->queue->rt2x00dev->cap_flags)) {
+		head_size += 8;
+		tail_size += 8;
+	}
+
+	length = min(length, skb->len);
+
+	nskb = dev_alloc_skb(head_size + 3 + length + tail_size);
+	if (!nskb)
+		return NULL;
+
+	/*
+	 * Give the copy the same alignment the frame had in the
+	 * original buffer (head_size is a multiple of 4).
+	 */
+	skb_reserve(nskb, head_size);
+	skb_reserve(nskb, (ALIGN_SIZE(skb, 0) - ALIGN_SIZE(nskb, 0)) & 3);
+	memcpy(skb_put(nskb, length), skb->data, length);
+
+	/*
+	 * The skb descriptor is still needed for the frame dump,
+	 * but the copy itself is not DMA mapped.
+	 */
+	memcpy(nskb->cb, skb->cb, sizeof(nskb->cb));
+	get_skb_frame_desc(nskb)->flags &= ~SKBDESC_DMA_MAPPED_RX;
+
+	return nskb;
+}
+
+void rt2x00queue_recycle_rxskb(struct queue_entry *entry, unsigned char *data)
+{
+	struct device *dev = entry->queue->rt2x00dev->dev;
+	struct sk_buff *skb = entry->skb;
+	struct skb_frame_desc *skbdesc = get_skb_frame_desc(skb);
+	unsigned int frame_size =
+	    entry->queue->data_size + entry->queue->desc_size;
+
+	/*
+	 * Parsing the frame only ever pulled data from the front,
+	 * so push it back and restore the original length.
+	 */
+	skb_push(skb, skb->data - data);
+	skb_trim(skb, 0);
+	skb_put(skb, frame_size);
+
+	if (skbdesc->flags & SKBDESC_DMA_MAPPED_RX)
+		dma_sync_single_for_device(dev, skbdesc->skb_dma,
+					   min_t(unsigned int, frame_size,
+						 RX_SYNC_SIZE),
+					   DMA_FROM_DEVICE);
+}
+
 void rt2x00queue_map_txskb(struct queue_entry *entry)
 {
 	struct device *dev = entry->queue->rt2x00dev->dev;
@@ -546,6 +624,8 @@ static void rt2x00queue_write_tx_descriptor(struct queue_entry *entry,
 static void rt2x00queue_kick_tx_queue(struct data_queue *queue,
 				      struct txentry_desc *txdesc)
 {
+	unsigned long irqflags;
+
 	/*
 	 * Check if we need to kick the queue, there are however a few rules
 	 *	1) Don't kick unless this is the last in frame in a burst.
@@ -554,10 +634,19 @@ static void rt2x00queue_kick_tx_queue(struct data_queue *queue,
 	 *	   This is true for fragments, RTS or CTS-to-self frames.
 	 *	2) Rule 1 can be broken when the available entries
 	 *	   in the queue are less then a certain threshold.
+	 *	Since mac80211 flags frames from its pending queue with
+	 *	IEEE80211_TX_CTL_MORE_FRAMES while more of them follow,
+	 *	a whole batch only costs a single kick (a single ring
+	 *	index write on PCI, a single pass over the URBs on USB).
 	 */
 	if (rt2x00queue_threshold(queue) ||
-	    !test_bit(ENTRY_TXD_BURST, &txdesc->flags))
+	    !test_bit(ENTRY_TXD_BURST, &txdesc->flags)) {
 		queue->rt2x00dev->ops->lib->kick_queue(queue);
+
+		spin_lock_irqsave(&queue->index_lock, irqflags);
+		queue->kick_count++;
+		spin_unlock_irqrestore(&queue->index_lock, irqflags);
+	}
 }
 
 int rt2x00queue_write_tx_frame(struct data_queue *queue, struct sk_buff *skb,
@@ -1057,6 +1146,7 @@ static void rt2x00queue_reset(struct data_queue *queue)
 	spin_lock_irqsave(&queue->index_lock, irqflags);
 
 	queue->count = 0;
+	queue->kick_count = 0;
 	queue->length = 0;
 
 	for (i = 0; i < Q_INDEX_MAX; i++)
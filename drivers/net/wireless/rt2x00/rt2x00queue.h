@@ -42,6 +42,19 @@
 #define MGMT_FRAME_SIZE		256
 #define AGGREGATION_SIZE	3840
 
+/**
+ * DOC: RX copybreak
+ *
+ * Received frames up to RX_COPYBREAK bytes are copied into a small skb,
+ * after which the (DMA mapped) RX buffer is handed back to the hardware
+ * as it is. Only RX_SYNC_SIZE bytes at the start of the buffer are synced
+ * for the CPU before the frame size is known, this covers the RX
+ * descriptor some chipsets place in front of the frame as well as any
+ * frame which will be copied.
+ */
+#define RX_COPYBREAK		256
+#define RX_SYNC_SIZE		(RX_COPYBREAK + 64)
+
 /**
  * enum data_queue_qid: Queue identification
  *
@@ -438,6 +451,8 @@ enum data_queue_flags {
  *	@index_crypt needs to be changed this lock should be grabbed to prevent
  *	index corruption due to concurrency.
  * @count: Number of frames handled in the queue.
+ * @kick_count: Number of times the TX path kicked the queue to the hardware,
+ *	compared against @count this shows how well frames are batched.
  * @limit: Maximum number of entries in the queue.
  * @threshold: Minimum number of free entries before queue is kicked by force.
  * @length: Number of frames in queue.
@@ -464,6 +479,7 @@ struct data_queue {
 	spinlock_t index_lock;
 
 	unsigned int count;
+	unsigned int kick_count;
 	unsigned short limit;
 	unsigned short threshold;
 	unsigned short length;
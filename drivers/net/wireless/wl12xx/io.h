@@ -129,6 +129,28 @@ static inline void wl1271_write(struct wl1271 *wl, int addr, void *buf,
 	wl1271_raw_write(wl, physical, buf, len, fixed);
 }
 
+static inline int wl1271_read_sg(struct wl1271 *wl, int addr,
+				 struct scatterlist *sg, unsigned int sg_len,
+				 size_t len, bool fixed)
+{
+	int physical;
+
+	physical = wl1271_translate_addr(wl, addr);
+
+	return wl->if_ops->read_sg(wl, physical, sg, sg_len, len, fixed);
+}
+
+static inline int wl1271_write_sg(struct wl1271 *wl, int addr,
+				  struct scatterlist *sg, unsigned int sg_len,
+				  size_t len, bool fixed)
+{
+	int physical;
+
+	physical = wl1271_translate_addr(wl, addr);
+
+	return wl->if_ops->write_sg(wl, physical, sg, sg_len, len, fixed);
+}
+
 static inline void wl1271_read_hwaddr(struct wl1271 *wl, int hwaddr,
 				      void *buf, size_t len, bool fixed)
 {
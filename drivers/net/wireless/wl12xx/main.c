@@ -932,6 +932,35 @@ static void wl1271_netstack_work(struct work_struct *work)
 
 #define WL1271_IRQ_MAX_LOOPS 256
 
+/*
+ * Under sustained traffic every interrupt finds more work once it's done.
+ * After WL1271_IRQ_POLL_ENTER busy loops the IRQ work keeps polling the
+ * FW status (the line stays masked while the threaded handler runs) and
+ * only goes back to interrupts after WL1271_IRQ_POLL_IDLE empty polls.
+ */
+#define WL1271_IRQ_POLL_ENTER		4
+#define WL1271_IRQ_POLL_IDLE		4
+#define WL1271_IRQ_POLL_INTERVAL	100	/* in microseconds */
+
+/* Feed the TX path if the FW has room for more frames, wl->mutex held */
+static void wl1271_irq_feed_tx(struct wl1271 *wl)
+{
+	unsigned long flags;
+
+	spin_lock_irqsave(&wl->wl_lock, flags);
+	if (!test_bit(WL1271_FLAG_FW_TX_BUSY, &wl->flags) &&
+	    wl1271_tx_total_queue_count(wl) > 0) {
+		spin_unlock_irqrestore(&wl->wl_lock, flags);
+		/*
+		 * In order to avoid starvation of the TX path,
+		 * call the work function directly.
+		 */
+		wl1271_tx_work_locked(wl);
+	} else {
+		spin_unlock_irqrestore(&wl->wl_lock, flags);
+	}
+}
+
 irqreturn_t wl1271_irq(int irq, void *cookie)
 {
 	int ret;
@@ -939,6 +968,8 @@ irqreturn_t wl1271_irq(int irq, void *cookie)
 	int loopcount = WL1271_IRQ_MAX_LOOPS;
 	struct wl1271 *wl = (struct wl1271 *)cookie;
 	bool done = false;
+	bool polling = false;
+	unsigned int busy_loops = 0, idle_polls = 0;
 	unsigned int defer_count;
 	unsigned long flags;
 
@@ -964,6 +995,8 @@ irqreturn_t wl1271_irq(int irq, void *cookie)
 	if (ret < 0)
 		goto out;
 
+	wl->stats.irq_count++;
+
 	while (!done && loopcount--) {
 		/*
 		 * In order to avoid a race with the hardirq, clear the flag
@@ -977,10 +1010,45 @@ irqreturn_t wl1271_irq(int irq, void *cookie)
 		intr = le32_to_cpu(wl->fw_status->intr);
 		intr &= WL1271_INTR_MASK;
 		if (!intr) {
+			if (polling && idle_polls++ < WL1271_IRQ_POLL_IDLE) {
+				wl->stats.irq_idle_polls++;
+
+				/* keep feeding the FW while we wait */
+				wl1271_irq_feed_tx(wl);
+
+				/*
+				 * Don't hold off the mac80211 ops and the TX
+				 * work while sleeping. The chip can only have
+				 * gone to ELP meanwhile if the sleep overran
+				 * the ELP entry delay. Waking it up would need
+				 * the IRQ line that is masked while we run, so
+				 * stop polling in that case.
+				 */
+				mutex_unlock(&wl->mutex);
+				usleep_range(WL1271_IRQ_POLL_INTERVAL,
+					     2 * WL1271_IRQ_POLL_INTERVAL);
+				mutex_lock(&wl->mutex);
+
+				if (unlikely(wl->state == WL1271_STATE_OFF) ||
+				    test_bit(WL1271_FLAG_IN_ELP, &wl->flags))
+					goto out;
+
+				ret = wl1271_ps_elp_wakeup(wl);
+				if (ret < 0)
+					goto out;
+				continue;
+			}
 			done = true;
 			continue;
 		}
 
+		idle_polls = 0;
+		if (polling)
+			wl->stats.irq_polls++;
+		else if (++busy_loops >= WL1271_IRQ_POLL_ENTER &&
+			 !(wl->platform_quirks & WL12XX_PLATFORM_QUIRK_EDGE_IRQ))
+			polling = true;
+
 		if (unlikely(intr & WL1271_ACX_INTR_WATCHDOG)) {
 			wl1271_error("watchdog interrupt received! "
 				     "starting recovery.");
@@ -996,18 +1064,7 @@ irqreturn_t wl1271_irq(int irq, void *cookie)
 			wl12xx_rx(wl, wl->fw_status);
 
 			/* Check if any tx blocks were freed */
-			spin_lock_irqsave(&wl->wl_lock, flags);
-			if (!test_bit(WL1271_FLAG_FW_TX_BUSY, &wl->flags) &&
-			    wl1271_tx_total_queue_count(wl) > 0) {
-				spin_unlock_irqrestore(&wl->wl_lock, flags);
-				/*
-				 * In order to avoid starvation of the TX path,
-				 * call the work function directly.
-				 */
-				wl1271_tx_work_locked(wl);
-			} else {
-				spin_unlock_irqrestore(&wl->wl_lock, flags);
-			}
+			wl1271_irq_feed_tx(wl);
 
 			/* check for tx results */
 			if (wl->fw_status->tx_results_counter !=
@@ -2088,6 +2145,7 @@ deinit:
 	wl->tx_allocated_blocks = 0;
 	wl->tx_results_count = 0;
 	wl->tx_packets_count = 0;
+	wl->tx_aggr_size = WL1271_AGGR_BUFFER_SIZE;
 	wl->time_offset = 0;
 	wl->session_counter = 0;
 	wl->rate_set = CONF_TX_RATE_MASK_BASIC;
@@ -4902,11 +4960,19 @@ struct ieee80211_hw *wl1271_alloc_hw(void)
 		ret = -ENOMEM;
 		goto err_wq;
 	}
+	wl->tx_aggr_size = WL1271_AGGR_BUFFER_SIZE;
+
+	wl->tx_pad_buf = kzalloc(WL12XX_BUS_BLOCK_SIZE, GFP_KERNEL);
+	if (!wl->tx_pad_buf) {
+		ret = -ENOMEM;
+		goto err_aggr;
+	}
+	sg_init_table(wl->tx_sg, WL1271_TX_SG_MAX);
 
 	wl->dummy_packet = wl12xx_alloc_dummy_packet(wl);
 	if (!wl->dummy_packet) {
 		ret = -ENOMEM;
-		goto err_aggr;
+		goto err_pad;
 	}
 
 	/* Allocate one page for the FW log */
@@ -4962,6 +5028,9 @@ err_fwlog:
 err_dummy_packet:
 	dev_kfree_skb(wl->dummy_packet);
 
+err_pad:
+	kfree(wl->tx_pad_buf);
+
 err_aggr:
 	free_pages((unsigned long)wl->aggr_buf, order);
 
@@ -4997,6 +5066,7 @@ int wl1271_free_hw(struct wl1271 *wl)
 	platform_device_unregister(wl->plat_dev);
 	free_page((unsigned long)wl->fwlog);
 	dev_kfree_skb(wl->dummy_packet);
+	kfree(wl->tx_pad_buf);
 	free_pages((unsigned long)wl->aggr_buf,
 			get_order(WL1271_AGGR_BUFFER_SIZE));
 	kfree(wl->plat_dev);
@@ -95,24 +95,31 @@ static void wl1271_rx_status(struct wl1271 *wl,
 	}
 }
 
+/*
+ * If skb is set, the packet (descriptor included) was read straight into
+ * it and data points to skb->data; otherwise the packet is copied out of
+ * the aggregation buffer at data.
+ */
 static int wl1271_rx_handle_data(struct wl1271 *wl, u8 *data, u32 length,
-				 bool unaligned)
+				 bool unaligned, struct sk_buff *skb)
 {
 	struct wl1271_rx_descriptor *desc;
-	struct sk_buff *skb;
 	struct ieee80211_hdr *hdr;
 	u8 *buf;
 	u8 beacon = 0;
 	u8 is_data = 0;
 	u8 reserved = unaligned ? NET_IP_ALIGN : 0;
 	u16 seq_num;
+	int ret = 0;
 
 	/*
 	 * In PLT mode we seem to get frames and mac80211 warns about them,
 	 * workaround this by not retrieving them at all.
 	 */
-	if (unlikely(wl->state == WL1271_STATE_PLT))
-		return -EINVAL;
+	if (unlikely(wl->state == WL1271_STATE_PLT)) {
+		ret = -EINVAL;
+		goto drop;
+	}
 
 	/* the data read starts with the descriptor */
 	desc = (struct wl1271_rx_descriptor *) data;
@@ -121,7 +128,7 @@ static int wl1271_rx_handle_data(struct wl1271 *wl, u8 *data, u32 length,
 		size_t len = length - sizeof(*desc);
 		wl12xx_copy_fwlog(wl, data + sizeof(*desc), len);
 		wake_up_interruptible(&wl->fwlog_waitq);
-		return 0;
+		goto drop;
 	}
 
 	switch (desc->status & WL1271_RX_DESC_STATUS_MASK) {
@@ -130,14 +137,22 @@ static int wl1271_rx_handle_data(struct wl1271 *wl, u8 *data, u32 length,
 	case WL1271_RX_DESC_DECRYPT_FAIL:
 		wl1271_warning("corrupted packet in RX with status: 0x%x",
 			       desc->status & WL1271_RX_DESC_STATUS_MASK);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto drop;
 	case WL1271_RX_DESC_SUCCESS:
 	case WL1271_RX_DESC_MIC_FAIL:
 		break;
 	default:
 		wl1271_error("invalid RX descriptor status: 0x%x",
 			     desc->status & WL1271_RX_DESC_STATUS_MASK);
-		return -EINVAL;
+		ret = -EINVAL;
+		goto drop;
+	}
+
+	if (skb) {
+		/* the payload alignment was taken care of before the read */
+		skb_pull(skb, sizeof(*desc));
+		goto deliver;
 	}
 
 	/* skb length not included rx descriptor */
@@ -160,6 +175,7 @@ static int wl1271_rx_handle_data(struct wl1271 *wl, u8 *data, u32 length,
 	 */
 	memcpy(buf, data + sizeof(*desc), length - sizeof(*desc));
 
+deliver:
 	hdr = (struct ieee80211_hdr *)skb->data;
 	if (ieee80211_is_beacon(hdr->frame_control))
 		beacon = 1;
@@ -180,6 +196,70 @@ static int wl1271_rx_handle_data(struct wl1271 *wl, u8 *data, u32 length,
 	queue_work(wl->freezable_wq, &wl->netstack_work);
 
 	return is_data;
+
+drop:
+	if (skb)
+		dev_kfree_skb(skb);
+	return ret;
+}
+
+/*
+ * Read num_pkts packets straight into freshly allocated skbs, so that
+ * they don't have to be copied out of the aggregation buffer. Each skb
+ * gets the same NET_IP_ALIGN headroom the copy would have used, so the
+ * payload ends up aligned once the descriptor is pulled.
+ *
+ * Returns -EAGAIN if nothing was read and the caller should use the
+ * aggregation buffer instead.
+ */
+static int wl12xx_rx_read_skbs(struct wl1271 *wl,
+			       struct wl12xx_fw_status *status,
+			       u32 rx_counter, int num_pkts, u32 buf_size,
+			       struct sk_buff **skbs)
+{
+	struct sk_buff *skb;
+	u32 pkt_length;
+	u8 reserved;
+	int i, ret;
+
+	sg_init_table(wl->rx_sg, num_pkts);
+
+	for (i = 0; i < num_pkts; i++) {
+		pkt_length = wl12xx_rx_get_buf_size(status, rx_counter);
+		reserved = wl12xx_rx_get_unaligned(status, rx_counter) ?
+			   NET_IP_ALIGN : 0;
+
+		skb = __dev_alloc_skb(pkt_length + reserved, GFP_KERNEL);
+		if (!skb) {
+			ret = -EAGAIN;
+			goto out_free;
+		}
+
+		skb_reserve(skb, reserved);
+		sg_set_buf(&wl->rx_sg[i], skb_put(skb, pkt_length),
+			   pkt_length);
+		skbs[i] = skb;
+
+		rx_counter++;
+		rx_counter &= NUM_RX_PKT_DESC_MOD_MASK;
+	}
+
+	ret = wl1271_read_sg(wl, WL1271_SLV_MEM_DATA, wl->rx_sg, num_pkts,
+			     buf_size, true);
+	if (!ret)
+		return 0;
+
+	if (ret == -EINVAL) {
+		/* the host rejected the list before reading anything */
+		wl1271_warning("sg rx not supported by host, disabling");
+		wl->rx_sg_max = 0;
+		ret = -EAGAIN;
+	}
+
+out_free:
+	while (i--)
+		dev_kfree_skb(skbs[i]);
+	return ret;
 }
 
 void wl12xx_rx(struct wl1271 *wl, struct wl12xx_fw_status *status)
@@ -195,15 +275,25 @@ void wl12xx_rx(struct wl1271 *wl, struct wl12xx_fw_status *status)
 	bool is_ap = (wl->bss_type == BSS_TYPE_AP_BSS);
 	bool had_data = false;
 	bool unaligned = false;
+	struct sk_buff *skbs[NUM_RX_PKT_DESC];
+	int num_pkts, max_pkts, i, ret;
 
 	while (drv_rx_counter != fw_rx_counter) {
+		/*
+		 * Take as many of the packets the FW reported as one transfer
+		 * can carry: bounded by the aggregation buffer and, when
+		 * reading into skbs, by the host's scatterlist length.
+		 */
+		max_pkts = wl->rx_sg_max ? wl->rx_sg_max : NUM_RX_PKT_DESC;
+		num_pkts = 0;
 		buf_size = 0;
 		rx_counter = drv_rx_counter;
-		while (rx_counter != fw_rx_counter) {
+		while (rx_counter != fw_rx_counter && num_pkts < max_pkts) {
 			pkt_length = wl12xx_rx_get_buf_size(status, rx_counter);
 			if (buf_size + pkt_length > WL1271_AGGR_BUFFER_SIZE)
 				break;
 			buf_size += pkt_length;
+			num_pkts++;
 			rx_counter++;
 			rx_counter &= NUM_RX_PKT_DESC_MOD_MASK;
 		}
@@ -234,12 +324,17 @@ void wl12xx_rx(struct wl1271 *wl, struct wl12xx_fw_status *status)
 		}
 
 		/* Read all available packets at once */
-		wl1271_read(wl, WL1271_SLV_MEM_DATA, wl->aggr_buf,
-				buf_size, true);
+		ret = -EAGAIN;
+		if (wl->rx_sg_max)
+			ret = wl12xx_rx_read_skbs(wl, status, drv_rx_counter,
+						  num_pkts, buf_size, skbs);
+		if (ret == -EAGAIN)
+			wl1271_read(wl, WL1271_SLV_MEM_DATA, wl->aggr_buf,
+				    buf_size, true);
 
 		/* Split data into separate packets */
 		pkt_offset = 0;
-		while (pkt_offset < buf_size) {
+		for (i = 0; i < num_pkts; i++) {
 			pkt_length = wl12xx_rx_get_buf_size(status,
 					drv_rx_counter);
 
@@ -249,12 +344,21 @@ void wl12xx_rx(struct wl1271 *wl, struct wl12xx_fw_status *status)
 			/*
 			 * the handle data call can only fail in memory-outage
 			 * conditions, in that case the received frame will just
-			 * be dropped.
+			 * be dropped. A failed read into the skbs drops the
+			 * whole batch.
 			 */
-			if (wl1271_rx_handle_data(wl,
-						  wl->aggr_buf + pkt_offset,
-						  pkt_length, unaligned) == 1)
-				had_data = true;
+			if (!ret) {
+				if (wl1271_rx_handle_data(wl, skbs[i]->data,
+							  pkt_length, unaligned,
+							  skbs[i]) == 1)
+					had_data = true;
+			} else if (ret == -EAGAIN) {
+				if (wl1271_rx_handle_data(wl,
+						wl->aggr_buf + pkt_offset,
+						pkt_length, unaligned,
+						NULL) == 1)
+					had_data = true;
+			}
 
 			wl->rx_counter++;
 			drv_rx_counter++;
@@ -27,7 +27,9 @@
 #include <linux/mmc/sdio_func.h>
 #include <linux/mmc/sdio_ids.h>
 #include <linux/mmc/card.h>
+#include <linux/mmc/core.h>
 #include <linux/mmc/host.h>
+#include <linux/mmc/sdio.h>
 #include <linux/gpio.h>
 #include <linux/wl12xx.h>
 #include <linux/pm_runtime.h>
@@ -35,6 +37,7 @@
 #include "wl12xx.h"
 #include "wl12xx_80211.h"
 #include "io.h"
+#include "tx.h"
 
 #ifndef SDIO_VENDOR_ID_TI
 #define SDIO_VENDOR_ID_TI		0x0097
@@ -156,6 +159,148 @@ static void wl1271_sdio_raw_write(struct wl1271 *wl, int addr, void *buf,
 		wl1271_error("sdio write failed (%d)", ret);
 }
 
+static int wl1271_sdio_cmd53_sg(struct sdio_func *func, bool write, int addr,
+				bool fixed, struct scatterlist *sg,
+				unsigned int sg_len, unsigned int blksz,
+				unsigned int blocks, bool block_mode)
+{
+	struct mmc_card *card = func->card;
+	struct mmc_request mrq;
+	struct mmc_command cmd;
+	struct mmc_data data;
+
+	memset(&mrq, 0, sizeof(mrq));
+	memset(&cmd, 0, sizeof(cmd));
+	memset(&data, 0, sizeof(data));
+
+	mrq.cmd = &cmd;
+	mrq.data = &data;
+
+	cmd.opcode = SD_IO_RW_EXTENDED;
+	cmd.arg = write ? 0x80000000 : 0x00000000;
+	cmd.arg |= func->num << 28;
+	cmd.arg |= fixed ? 0 : 0x04000000;	/* incrementing address */
+	cmd.arg |= addr << 9;
+	if (block_mode)
+		cmd.arg |= 0x08000000 | blocks;
+	else
+		cmd.arg |= (blksz == 512) ? 0 : blksz;	/* byte mode */
+	cmd.flags = MMC_RSP_SPI_R5 | MMC_RSP_R5 | MMC_CMD_ADTC;
+
+	data.blksz = blksz;
+	data.blocks = blocks;
+	data.flags = write ? MMC_DATA_WRITE : MMC_DATA_READ;
+	data.sg = sg;
+	data.sg_len = sg_len;
+
+	mmc_set_data_timeout(&data, card);
+	mmc_wait_for_req(card->host, &mrq);
+
+	if (cmd.error)
+		return cmd.error;
+	if (data.error)
+		return data.error;
+	if (!mmc_host_is_spi(card->host) &&
+	    (cmd.resp[0] & (R5_ERROR | R5_FUNCTION_NUMBER | R5_OUT_OF_RANGE)))
+		return -EIO;
+
+	return 0;
+}
+
+/*
+ * The SDIO core only takes linear buffers, so build the CMD53s by hand to
+ * move a scatterlist in one block-mode transfer plus, if the length isn't
+ * a whole number of blocks, one byte-mode transfer for the remainder.
+ * The entry holding the block boundary is split in place, so the list
+ * can't be reused as is.
+ *
+ * Returns -EINVAL if the host refused the request before moving any data.
+ */
+static int wl1271_sdio_raw_rw_sg(struct wl1271 *wl, int addr,
+				 struct scatterlist *sg, unsigned int sg_len,
+				 size_t len, bool fixed, bool write)
+{
+	struct sdio_func *func = wl_to_func(wl);
+	unsigned int blksz = func->cur_blksize;
+	unsigned int blocks = len / blksz;
+	unsigned int rest = len % blksz;
+	unsigned int head = blocks * blksz;
+	unsigned int i = 0;
+	bool moved = false;
+	int ret;
+
+	wl1271_debug(DEBUG_SDIO, "sdio %s 53 addr 0x%x, %zu bytes, %u sg",
+		     write ? "write" : "read", addr, len, sg_len);
+
+	if (blocks && rest) {
+		/* find the entry the block boundary falls into */
+		unsigned int off = 0;
+
+		while (off + sg[i].length <= head)
+			off += sg[i++].length;
+
+		if (off < head) {
+			unsigned int split = head - off;
+			void *buf = sg_virt(&sg[i]);
+			unsigned int buf_len = sg[i].length;
+
+			sg[i].length = split;
+			ret = wl1271_sdio_cmd53_sg(func, write, addr, fixed,
+						   sg, i + 1, blksz, blocks,
+						   true);
+			if (ret) {
+				sg[i].length = buf_len;
+				goto out;
+			}
+			sg_set_buf(&sg[i], buf + split, buf_len - split);
+		} else {
+			ret = wl1271_sdio_cmd53_sg(func, write, addr, fixed,
+						   sg, i, blksz, blocks, true);
+		}
+		if (ret)
+			goto out;
+
+		if (!fixed)
+			addr += head;
+		blocks = 0;
+		moved = true;
+	}
+
+	if (blocks) {
+		ret = wl1271_sdio_cmd53_sg(func, write, addr, fixed, sg,
+					   sg_len, blksz, blocks, true);
+	} else {
+		ret = wl1271_sdio_cmd53_sg(func, write, addr, fixed, sg + i,
+					   sg_len - i, rest, 1, false);
+		/* part of the data already went through */
+		if (ret == -EINVAL && moved)
+			ret = -EIO;
+	}
+
+out:
+	if (ret)
+		wl1271_error("sdio sg %s failed (%d)",
+			     write ? "write" : "read", ret);
+
+	return ret;
+}
+
+static int wl1271_sdio_raw_read_sg(struct wl1271 *wl, int addr,
+				   struct scatterlist *sg,
+				   unsigned int sg_len, size_t len,
+				   bool fixed)
+{
+	return wl1271_sdio_raw_rw_sg(wl, addr, sg, sg_len, len, fixed, false);
+}
+
+static int wl1271_sdio_raw_write_sg(struct wl1271 *wl, int addr,
+				    struct scatterlist *sg,
+				    unsigned int sg_len, size_t len,
+				    bool fixed)
+{
+	return wl1271_sdio_raw_rw_sg(wl, addr, sg, sg_len, len, fixed, true);
+}
+
 static int wl1271_sdio_power_on(struct wl1271 *wl)
 {
 	struct sdio_func *func = wl_to_func(wl);
@@ -211,6 +356,8 @@ static int wl1271_sdio_set_power(struct wl1271 *wl, bool enable)
 static struct wl1271_if_operations sdio_ops = {
 	.read		= wl1271_sdio_raw_read,
 	.write		= wl1271_sdio_raw_write,
+	.read_sg	= wl1271_sdio_raw_read_sg,
+	.write_sg	= wl1271_sdio_raw_write_sg,
 	.power		= wl1271_sdio_set_power,
 	.dev		= wl1271_sdio_wl_to_dev,
 	.enable_irq	= wl1271_sdio_enable_interrupts,
@@ -224,6 +371,7 @@ static int __devinit wl1271_probe(struct sdio_func *func,
 	struct ieee80211_hw *hw;
 	const struct wl12xx_platform_data *wlan_data;
 	struct wl1271 *wl;
+	struct mmc_host *host;
 	unsigned long irqflags;
 	mmc_pm_flag_t mmcflags;
 	int ret;
@@ -247,6 +395,22 @@ static int __devinit wl1271_probe(struct sdio_func *func,
 	/* Use block mode for transferring over one block size of data */
 	func->card->quirks |= MMC_QUIRK_BLKSZ_FOR_BYTE_MODE;
 
+	/*
+	 * Move TX and RX aggregates straight from/to the skbs if the host
+	 * can take a whole aggregate in one request (at most 511 blocks
+	 * per CMD53).
+	 */
+	host = func->card->host;
+	if (host->max_segs >= 4 && host->max_seg_size >= PAGE_SIZE &&
+	    host->max_req_size >= WL1271_AGGR_BUFFER_SIZE &&
+	    min(host->max_blk_count, 511u) * WL12XX_BUS_BLOCK_SIZE >=
+	    WL1271_AGGR_BUFFER_SIZE) {
+		wl->tx_sg_max = min_t(unsigned int, host->max_segs,
+				      WL1271_TX_SG_MAX);
+		wl->rx_sg_max = min_t(unsigned int, host->max_segs,
+				      NUM_RX_PKT_DESC);
+	}
+
 	wlan_data = wl12xx_get_platform_data();
 	if (IS_ERR(wlan_data)) {
 		ret = PTR_ERR(wlan_data);
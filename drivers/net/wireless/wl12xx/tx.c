@@ -208,6 +208,17 @@ static unsigned int wl12xx_calc_packet_alignment(struct wl1271 *wl,
 		return ALIGN(packet_length, WL1271_TX_ALIGN_TO);
 }
 
+/*
+ * Aggregated packets can be written straight from the skbs when every
+ * packet is padded to whole bus blocks, so the scatterlist adds up to a
+ * single block-mode transfer.
+ */
+static bool wl1271_tx_use_sg(struct wl1271 *wl)
+{
+	return wl->tx_sg_max &&
+	       (wl->quirks & WL12XX_QUIRK_BLOCKSIZE_ALIGNMENT);
+}
+
 static int wl1271_tx_allocate(struct wl1271 *wl, struct sk_buff *skb, u32 extra,
 				u32 buf_offset, u8 hlid)
 {
@@ -221,6 +232,14 @@ static int wl1271_tx_allocate(struct wl1271 *wl, struct sk_buff *skb, u32 extra,
 	if (buf_offset + total_len > WL1271_AGGR_BUFFER_SIZE)
 		return -EAGAIN;
 
+	/* the first packet always goes, whatever the current limit */
+	if (buf_offset && buf_offset + total_len > wl->tx_aggr_size)
+		return -EAGAIN;
+
+	/* out of scatterlist entries for this transfer */
+	if (wl1271_tx_use_sg(wl) && wl->tx_sg_cnt + 2 > wl->tx_sg_max)
+		return -EAGAIN;
+
 	/* allocate free identifier for the packet */
 	id = wl1271_alloc_tx_id(wl, skb);
 	if (id < 0)
@@ -440,8 +459,16 @@ static int wl1271_prepare_tx_frame(struct wl1271 *wl, struct sk_buff *skb,
 	 */
 	total_len = wl12xx_calc_packet_alignment(wl, skb->len);
 
-	memcpy(wl->aggr_buf + buf_offset, skb->data, skb->len);
-	memset(wl->aggr_buf + buf_offset + skb->len, 0, total_len - skb->len);
+	if (wl1271_tx_use_sg(wl)) {
+		sg_set_buf(&wl->tx_sg[wl->tx_sg_cnt++], skb->data, skb->len);
+		if (total_len > skb->len)
+			sg_set_buf(&wl->tx_sg[wl->tx_sg_cnt++], wl->tx_pad_buf,
+				   total_len - skb->len);
+	} else {
+		memcpy(wl->aggr_buf + buf_offset, skb->data, skb->len);
+		memset(wl->aggr_buf + buf_offset + skb->len, 0,
+		       total_len - skb->len);
+	}
 
 	/* Revert side effects in the dummy packet skb, so it can be reused */
 	if (wl12xx_is_dummy_packet(wl, skb))
@@ -639,6 +666,38 @@ static bool wl1271_tx_is_data_present(struct sk_buff *skb)
 	return ieee80211_is_data_present(hdr->frame_control);
 }
 
+static void wl1271_tx_flush_aggr(struct wl1271 *wl, u32 buf_offset)
+{
+	int ret;
+
+	if (!wl->tx_sg_cnt) {
+		wl1271_write(wl, WL1271_SLV_MEM_DATA, wl->aggr_buf,
+			     buf_offset, true);
+		return;
+	}
+
+	sg_mark_end(&wl->tx_sg[wl->tx_sg_cnt - 1]);
+	ret = wl1271_write_sg(wl, WL1271_SLV_MEM_DATA, wl->tx_sg,
+			      wl->tx_sg_cnt, buf_offset, true);
+	if (ret == -EINVAL) {
+		/*
+		 * The host rejected the list (e.g. it wants every entry to
+		 * be a whole number of blocks) before moving any data.
+		 * Send this aggregate through the bounce buffer and stay
+		 * there from now on.
+		 */
+		wl1271_warning("sg tx not supported by host, disabling");
+		wl->tx_sg_max = 0;
+		sg_copy_to_buffer(wl->tx_sg, wl->tx_sg_cnt, wl->aggr_buf,
+				  buf_offset);
+		wl1271_write(wl, WL1271_SLV_MEM_DATA, wl->aggr_buf,
+			     buf_offset, true);
+	}
+
+	sg_init_table(wl->tx_sg, WL1271_TX_SG_MAX);
+	wl->tx_sg_cnt = 0;
+}
+
 void wl1271_tx_work_locked(struct wl1271 *wl)
 {
 	struct sk_buff *skb;
@@ -662,8 +721,7 @@ void wl1271_tx_work_locked(struct wl1271 *wl)
 			 * Flush buffer and try again.
 			 */
 			wl1271_skb_queue_head(wl, skb);
-			wl1271_write(wl, WL1271_SLV_MEM_DATA, wl->aggr_buf,
-				     buf_offset, true);
+			wl1271_tx_flush_aggr(wl, buf_offset);
 			sent_packets = true;
 			buf_offset = 0;
 			continue;
@@ -686,8 +744,7 @@ void wl1271_tx_work_locked(struct wl1271 *wl)
 
 out_ack:
 	if (buf_offset) {
-		wl1271_write(wl, WL1271_SLV_MEM_DATA, wl->aggr_buf,
-				buf_offset, true);
+		wl1271_tx_flush_aggr(wl, buf_offset);
 		sent_packets = true;
 	}
 	if (sent_packets) {
@@ -733,6 +790,28 @@ out:
 	mutex_unlock(&wl->mutex);
 }
 
+/*
+ * Large aggregates only pay off at high PHY rates; at low rates they just
+ * hold the bus while the firmware can't drain the frames any faster.
+ */
+static u32 wl1271_tx_aggr_size_for_rate(u8 rate_class_index)
+{
+	/* MCS rates and OFDM rates of 24 Mbps and up come first */
+	if (rate_class_index <= CONF_HW_RXTX_RATE_24)
+		return WL1271_AGGR_BUFFER_SIZE;
+
+	/* the remaining rates interleave OFDM and CCK/PBCC */
+	switch (rate_class_index) {
+	case CONF_HW_RXTX_RATE_18:
+	case CONF_HW_RXTX_RATE_12:
+	case CONF_HW_RXTX_RATE_9:
+	case CONF_HW_RXTX_RATE_6:
+		return WL1271_AGGR_BUFFER_SIZE / 2;
+	default:
+		return WL1271_AGGR_BUFFER_SIZE / 4;
+	}
+}
+
 static void wl1271_tx_complete_packet(struct wl1271 *wl,
 				      struct wl1271_tx_hw_res_descr *result)
 {
@@ -762,6 +841,8 @@ static void wl1271_tx_complete_packet(struct wl1271 *wl,
 			info->flags |= IEEE80211_TX_STAT_ACK;
 		rate = wl1271_rate_to_idx(result->rate_class_index, wl->band);
 		retries = result->ack_failures;
+		wl->tx_aggr_size =
+			wl1271_tx_aggr_size_for_rate(result->rate_class_index);
 	} else if (result->status == TX_RETRY_EXCEEDED) {
 		wl->stats.excessive_retries++;
 		retries = result->ack_failures;
@@ -30,6 +30,7 @@
 #include <linux/spinlock.h>
 #include <linux/list.h>
 #include <linux/bitops.h>
+#include <linux/scatterlist.h>
 #include <net/mac80211.h>
 
 #include "conf.h"
@@ -168,6 +169,9 @@ extern u32 wl12xx_debug_level;
 
 #define WL1271_AGGR_BUFFER_SIZE (4 * PAGE_SIZE)
 
+/* Each aggregated TX packet takes at most one data and one padding entry */
+#define WL1271_TX_SG_MAX (2 * ACX_TX_DESCRIPTORS)
+
 enum wl1271_state {
 	WL1271_STATE_OFF,
 	WL1271_STATE_ON,
@@ -229,6 +233,11 @@ struct wl1271_stats {
 
 	unsigned int retry_count;
 	unsigned int excessive_retries;
+
+	/* IRQ work runs, and FW status polls done without an interrupt */
+	unsigned int irq_count;
+	unsigned int irq_polls;
+	unsigned int irq_idle_polls;
 };
 
 #define NUM_TX_QUEUES              4
@@ -303,6 +312,10 @@ struct wl1271_if_operations {
 		     bool fixed);
 	void (*write)(struct wl1271 *wl, int addr, void *buf, size_t len,
 		     bool fixed);
+	int (*read_sg)(struct wl1271 *wl, int addr, struct scatterlist *sg,
+		       unsigned int sg_len, size_t len, bool fixed);
+	int (*write_sg)(struct wl1271 *wl, int addr, struct scatterlist *sg,
+			unsigned int sg_len, size_t len, bool fixed);
 	void (*reset)(struct wl1271 *wl);
 	void (*init)(struct wl1271 *wl);
 	int (*power)(struct wl1271 *wl, bool enable);
@@ -482,6 +495,26 @@ struct wl1271 {
 	/* Intermediate buffer, used for packet aggregation */
 	u8 *aggr_buf;
 
+	/* Current TX aggregation limit, follows the last TX rate */
+	u32 tx_aggr_size;
+
+	/*
+	 * Scatter-gather TX: aggregated packets are written straight from
+	 * the skbs, block padding comes from tx_pad_buf. tx_sg_max is set
+	 * by the bus driver, 0 means the bus can't do it.
+	 */
+	unsigned int tx_sg_max;
+	unsigned int tx_sg_cnt;
+	struct scatterlist tx_sg[WL1271_TX_SG_MAX];
+	u8 *tx_pad_buf;
+
+	/*
+	 * Scatter-gather RX: packets are read straight into their skbs.
+	 * rx_sg_max is set by the bus driver, 0 means the bus can't do it.
+	 */
+	unsigned int rx_sg_max;
+	struct scatterlist rx_sg[NUM_RX_PKT_DESC];
+
 	/* Reusable dummy packet template */
 	struct sk_buff *dummy_packet;
 
@@ -47,8 +47,20 @@ struct inquiry_data {
 	__u8		ssp_mode;
 };
 
+/* Inquiry and advertising caches are hashed by bdaddr and bounded */
+#define HCI_CACHE_HASH_BITS	6
+#define HCI_CACHE_HASH_SIZE	(1 << HCI_CACHE_HASH_BITS)
+#define HCI_CACHE_MAX_DEFAULT	256
+
+struct hci_cache_stats {
+	unsigned long	hits;
+	unsigned long	misses;
+	unsigned long	evictions;
+};
+
 struct inquiry_entry {
-	struct inquiry_entry	*next;
+	struct list_head	list;
+	struct hlist_node	hnode;
 	__u32			timestamp;
 	struct inquiry_data	data;
 };
@@ -56,7 +68,10 @@ struct inquiry_entry {
 struct inquiry_cache {
 	spinlock_t		lock;
 	__u32			timestamp;
-	struct inquiry_entry	*list;
+	struct list_head	list;	/* most recently used first */
+	struct hlist_head	hash[HCI_CACHE_HASH_SIZE];
+	unsigned int		num;
+	struct hci_cache_stats	stats;
 };
 
 struct hci_conn_hash {
@@ -73,8 +88,21 @@ struct hci_chan_hash {
 	unsigned int     num;
 };
 
+/* Channels with queued data, indexed by the priority of their head skb */
+struct hci_chan_sched {
+	struct list_head ready[HCI_PRIO_MAX + 1];
+	unsigned int     num[HCI_PRIO_MAX + 1];
+	unsigned long    prio_mask;
+	unsigned int     round;
+
+	unsigned long    picks;
+	unsigned long    visits;
+	unsigned long    promotions;
+};
+
 struct bdaddr_list {
 	struct list_head list;
+	struct hlist_node hnode;
 	bdaddr_t bdaddr;
 };
 
@@ -117,6 +145,7 @@ struct oob_data {
 
 struct adv_entry {
 	struct list_head list;
+	struct hlist_node hnode;
 	bdaddr_t bdaddr;
 	u8 bdaddr_type;
 };
@@ -222,6 +251,11 @@ struct hci_dev {
 	struct inquiry_cache	inq_cache;
 	struct hci_conn_hash	conn_hash;
 	struct list_head	blacklist;
+	struct hlist_head	blacklist_hash[HCI_CACHE_HASH_SIZE];
+
+	spinlock_t		tx_sched_lock;
+	struct hci_chan_sched	acl_sched;
+	struct hci_chan_sched	le_sched;
 
 	struct list_head	uuids;
 
@@ -229,9 +263,14 @@ struct hci_dev {
 
 	struct list_head	remote_oob_data;
 
-	struct list_head	adv_entries;
+	struct list_head	adv_entries;	/* most recently used first */
+	struct hlist_head	adv_hash[HCI_CACHE_HASH_SIZE];
+	unsigned int		adv_num;
+	struct hci_cache_stats	adv_stats;
 	struct timer_list	adv_timer;
 
+	unsigned int		cache_max;
+
 	struct hci_dev_stats	stat;
 
 	struct sk_buff_head	driver_init;
@@ -325,7 +364,10 @@ struct hci_chan {
 
 	struct hci_conn *conn;
 	struct sk_buff_head data_q;
-	unsigned int	sent;
+
+	struct list_head sched_list;
+	unsigned int	sched_prio;
+	unsigned int	sched_round;
 };
 
 extern struct hci_proto *hci_proto[];
@@ -346,14 +388,20 @@ extern rwlock_t hci_cb_list_lock;
 static inline void inquiry_cache_init(struct hci_dev *hdev)
 {
 	struct inquiry_cache *c = &hdev->inq_cache;
+	int i;
+
 	spin_lock_init(&c->lock);
-	c->list = NULL;
+	INIT_LIST_HEAD(&c->list);
+	for (i = 0; i < HCI_CACHE_HASH_SIZE; i++)
+		INIT_HLIST_HEAD(&c->hash[i]);
+	c->num = 0;
+	memset(&c->stats, 0, sizeof(c->stats));
 }
 
 static inline int inquiry_cache_empty(struct hci_dev *hdev)
 {
 	struct inquiry_cache *c = &hdev->inq_cache;
-	return c->list == NULL;
+	return list_empty(&c->list);
 }
 
 static inline long inquiry_cache_age(struct hci_dev *hdev)
@@ -496,6 +544,21 @@ static inline void hci_chan_hash_init(struct hci_conn *c)
 	h->num = 0;
 }
 
+static inline void hci_chan_sched_init(struct hci_chan_sched *s)
+{
+	int i;
+
+	for (i = 0; i <= HCI_PRIO_MAX; i++) {
+		INIT_LIST_HEAD(&s->ready[i]);
+		s->num[i] = 0;
+	}
+	s->prio_mask = 0;
+	s->round = 1;
+	s->picks = 0;
+	s->visits = 0;
+	s->promotions = 0;
+}
+
 static inline void hci_chan_hash_add(struct hci_conn *c, struct hci_chan *chan)
 {
 	struct hci_chan_hash *h = &c->chan_hash;
@@ -523,6 +586,7 @@ void hci_conn_check_pending(struct hci_dev *hdev);
 
 struct hci_chan *hci_chan_create(struct hci_conn *conn);
 int hci_chan_del(struct hci_chan *chan);
+void hci_chan_sched_unlink(struct hci_chan *chan);
 void hci_chan_hash_flush(struct hci_conn *conn);
 
 struct hci_conn *hci_connect(struct hci_dev *hdev, int type, bdaddr_t *dst,
@@ -897,6 +961,8 @@ int hci_unregister_notifier(struct notifier_block *nb);
 
 int hci_send_cmd(struct hci_dev *hdev, __u16 opcode, __u32 plen, void *param);
 void hci_send_acl(struct hci_chan *chan, struct sk_buff *skb, __u16 flags);
+void hci_send_acl_list(struct hci_chan *chan, struct sk_buff_head *list,
+								__u16 flags);
 void hci_send_sco(struct hci_conn *conn, struct sk_buff *skb);
 
 void *hci_sent_cmd_data(struct hci_dev *hdev, __u16 opcode);
@@ -2628,6 +2628,20 @@ static inline void ieee80211_tx_status_ni(struct ieee80211_hw *hw,
 void ieee80211_tx_status_irqsafe(struct ieee80211_hw *hw,
 				 struct sk_buff *skb);
 
+/**
+ * ieee80211_tx_status_irqsafe_list - IRQ-safe transmit status for a batch
+ *
+ * Like ieee80211_tx_status_irqsafe() but takes a list of frames, e.g. all
+ * frames reclaimed by a single block-ack, and queues them for the status
+ * tasklet with one lock round trip per queue and one tasklet schedule.
+ *
+ * @hw: the hardware the frames were transmitted by
+ * @skbs: the frames that were transmitted, owned by mac80211 after this
+ *	call; the list is left empty
+ */
+void ieee80211_tx_status_irqsafe_list(struct ieee80211_hw *hw,
+				      struct sk_buff_head *skbs);
+
 /**
  * ieee80211_report_low_ack - report non-responding station
  *
@@ -968,6 +968,7 @@ struct hci_chan *hci_chan_create(struct hci_conn *conn)
 
 	chan->conn = conn;
 	skb_queue_head_init(&chan->data_q);
+	INIT_LIST_HEAD(&chan->sched_list);
 
 	tasklet_disable(&hdev->tx_task);
 	hci_chan_hash_add(conn, chan);
@@ -985,6 +986,7 @@ int hci_chan_del(struct hci_chan *chan)
 
 	tasklet_disable(&hdev->tx_task);
 	hci_chan_hash_del(conn, chan);
+	hci_chan_sched_unlink(chan);
 	tasklet_enable(&hdev->tx_task);
 
 	skb_queue_purge(&chan->data_q);
@@ -43,6 +43,7 @@
 #include <linux/rfkill.h>
 #include <linux/timer.h>
 #include <linux/crypto.h>
+#include <linux/jhash.h>
 #include <net/sock.h>
 
 #include <asm/system.h>
@@ -337,32 +338,50 @@ struct hci_dev *hci_dev_get(int index)
 	return hdev;
 }
 
+/* Hash bucket of a bdaddr in one of the bdaddr keyed tables */
+static inline struct hlist_head *hci_bdaddr_bucket(struct hlist_head *hash,
+							bdaddr_t *bdaddr)
+{
+	return &hash[jhash(bdaddr, sizeof(*bdaddr), 0) &
+						(HCI_CACHE_HASH_SIZE - 1)];
+}
+
 /* ---- Inquiry support ---- */
 static void inquiry_cache_flush(struct hci_dev *hdev)
 {
 	struct inquiry_cache *cache = &hdev->inq_cache;
-	struct inquiry_entry *next  = cache->list, *e;
+	struct inquiry_entry *e, *tmp;
 
 	BT_DBG("cache %p", cache);
 
-	cache->list = NULL;
-	while ((e = next)) {
-		next = e->next;
+	list_for_each_entry_safe(e, tmp, &cache->list, list) {
+		hlist_del(&e->hnode);
+		list_del(&e->list);
 		kfree(e);
 	}
+
+	cache->num = 0;
 }
 
 struct inquiry_entry *hci_inquiry_cache_lookup(struct hci_dev *hdev, bdaddr_t *bdaddr)
 {
 	struct inquiry_cache *cache = &hdev->inq_cache;
 	struct inquiry_entry *e;
+	struct hlist_node *n;
 
 	BT_DBG("cache %p, %s", cache, batostr(bdaddr));
 
-	for (e = cache->list; e; e = e->next)
-		if (!bacmp(&e->data.bdaddr, bdaddr))
-			break;
-	return e;
+	hlist_for_each_entry(e, n, hci_bdaddr_bucket(cache->hash, bdaddr),
+								hnode) {
+		if (!bacmp(&e->data.bdaddr, bdaddr)) {
+			list_move(&e->list, &cache->list);
+			cache->stats.hits++;
+			return e;
+		}
+	}
+
+	cache->stats.misses++;
+	return NULL;
 }
 
 void hci_inquiry_cache_update(struct hci_dev *hdev, struct inquiry_data *data)
@@ -374,13 +393,27 @@ void hci_inquiry_cache_update(struct hci_dev *hdev, struct inquiry_data *data)
 
 	ie = hci_inquiry_cache_lookup(hdev, &data->bdaddr);
 	if (!ie) {
-		/* Entry not in the cache. Add new one. */
+		/* Entry not in the cache. Make room for it if the cache is
+		 * full, by dropping the entries used least recently */
+		while (cache->num >= hdev->cache_max) {
+			ie = list_entry(cache->list.prev,
+						struct inquiry_entry, list);
+			hlist_del(&ie->hnode);
+			list_del(&ie->list);
+			kfree(ie);
+			cache->num--;
+			cache->stats.evictions++;
+		}
+
+		/* Add new one. */
 		ie = kzalloc(sizeof(struct inquiry_entry), GFP_ATOMIC);
 		if (!ie)
 			return;
 
-		ie->next = cache->list;
-		cache->list = ie;
+		list_add(&ie->list, &cache->list);
+		hlist_add_head(&ie->hnode,
+			hci_bdaddr_bucket(cache->hash, &data->bdaddr));
+		cache->num++;
 	}
 
 	memcpy(&ie->data, data, sizeof(*data));
@@ -395,8 +428,12 @@ static int inquiry_cache_dump(struct hci_dev *hdev, int num, __u8 *buf)
 	struct inquiry_entry *e;
 	int copied = 0;
 
-	for (e = cache->list; e && copied < num; e = e->next, copied++) {
+	list_for_each_entry(e, &cache->list, list) {
 		struct inquiry_data *data = &e->data;
+
+		if (copied == num)
+			break;
+
 		bacpy(&info->bdaddr, &data->bdaddr);
 		info->pscan_rep_mode	= data->pscan_rep_mode;
 		info->pscan_period_mode	= data->pscan_period_mode;
@@ -404,6 +441,7 @@ static int inquiry_cache_dump(struct hci_dev *hdev, int num, __u8 *buf)
 		memcpy(info->dev_class, data->dev_class, 3);
 		info->clock_offset	= data->clock_offset;
 		info++;
+		copied++;
 	}
 
 	BT_DBG("cache %p, copied %d", cache, copied);
@@ -1287,8 +1325,10 @@ struct bdaddr_list *hci_blacklist_lookup(struct hci_dev *hdev,
 						bdaddr_t *bdaddr)
 {
 	struct bdaddr_list *b;
+	struct hlist_node *n;
 
-	list_for_each_entry(b, &hdev->blacklist, list)
+	hlist_for_each_entry(b, n,
+			hci_bdaddr_bucket(hdev->blacklist_hash, bdaddr), hnode)
 		if (bacmp(bdaddr, &b->bdaddr) == 0)
 			return b;
 
@@ -1304,6 +1344,7 @@ int hci_blacklist_clear(struct hci_dev *hdev)
 
 		b = list_entry(p, struct bdaddr_list, list);
 
+		hlist_del(&b->hnode);
 		list_del(p);
 		kfree(b);
 	}
@@ -1328,6 +1369,8 @@ int hci_blacklist_add(struct hci_dev *hdev, bdaddr_t *bdaddr)
 	bacpy(&entry->bdaddr, bdaddr);
 
 	list_add(&entry->list, &hdev->blacklist);
+	hlist_add_head(&entry->hnode,
+			hci_bdaddr_bucket(hdev->blacklist_hash, bdaddr));
 
 	return mgmt_device_blocked(hdev, bdaddr);
 }
@@ -1345,6 +1388,7 @@ int hci_blacklist_del(struct hci_dev *hdev, bdaddr_t *bdaddr)
 		return -ENOENT;
 	}
 
+	hlist_del(&entry->hnode);
 	list_del(&entry->list);
 	kfree(entry);
 
@@ -1367,10 +1411,13 @@ int hci_adv_entries_clear(struct hci_dev *hdev)
 	struct adv_entry *entry, *tmp;
 
 	list_for_each_entry_safe(entry, tmp, &hdev->adv_entries, list) {
+		hlist_del(&entry->hnode);
 		list_del(&entry->list);
 		kfree(entry);
 	}
 
+	hdev->adv_num = 0;
+
 	BT_DBG("%s adv cache cleared", hdev->name);
 
 	return 0;
@@ -1379,11 +1426,18 @@ int hci_adv_entries_clear(struct hci_dev *hdev)
 struct adv_entry *hci_find_adv_entry(struct hci_dev *hdev, bdaddr_t *bdaddr)
 {
 	struct adv_entry *entry;
+	struct hlist_node *n;
 
-	list_for_each_entry(entry, &hdev->adv_entries, list)
-		if (bacmp(bdaddr, &entry->bdaddr) == 0)
+	hlist_for_each_entry(entry, n,
+			hci_bdaddr_bucket(hdev->adv_hash, bdaddr), hnode) {
+		if (bacmp(bdaddr, &entry->bdaddr) == 0) {
+			list_move(&entry->list, &hdev->adv_entries);
+			hdev->adv_stats.hits++;
 			return entry;
+		}
+	}
 
+	hdev->adv_stats.misses++;
 	return NULL;
 }
 
@@ -1408,6 +1462,17 @@ int hci_add_adv_entry(struct hci_dev *hdev,
 	if (hci_find_adv_entry(hdev, &ev->bdaddr))
 		return 0;
 
+	/* Drop the entries used least recently to stay within bounds */
+	while (hdev->adv_num >= hdev->cache_max) {
+		entry = list_entry(hdev->adv_entries.prev,
+						struct adv_entry, list);
+		hlist_del(&entry->hnode);
+		list_del(&entry->list);
+		kfree(entry);
+		hdev->adv_num--;
+		hdev->adv_stats.evictions++;
+	}
+
 	entry = kzalloc(sizeof(*entry), GFP_ATOMIC);
 	if (!entry)
 		return -ENOMEM;
@@ -1416,6 +1481,9 @@ int hci_add_adv_entry(struct hci_dev *hdev,
 	entry->bdaddr_type = ev->bdaddr_type;
 
 	list_add(&entry->list, &hdev->adv_entries);
+	hlist_add_head(&entry->hnode,
+			hci_bdaddr_bucket(hdev->adv_hash, &entry->bdaddr));
+	hdev->adv_num++;
 
 	BT_DBG("%s adv entry added: address %s type %u", hdev->name,
 				batostr(&entry->bdaddr), entry->bdaddr_type);
@@ -1486,9 +1554,15 @@ int hci_register_dev(struct hci_dev *hdev)
 
 	hci_conn_hash_init(hdev);
 
+	spin_lock_init(&hdev->tx_sched_lock);
+	hci_chan_sched_init(&hdev->acl_sched);
+	hci_chan_sched_init(&hdev->le_sched);
+
 	INIT_LIST_HEAD(&hdev->mgmt_pending);
 
 	INIT_LIST_HEAD(&hdev->blacklist);
+	for (i = 0; i < HCI_CACHE_HASH_SIZE; i++)
+		INIT_HLIST_HEAD(&hdev->blacklist_hash[i]);
 
 	INIT_LIST_HEAD(&hdev->uuids);
 
@@ -1497,6 +1571,11 @@ int hci_register_dev(struct hci_dev *hdev)
 	INIT_LIST_HEAD(&hdev->remote_oob_data);
 
 	INIT_LIST_HEAD(&hdev->adv_entries);
+	for (i = 0; i < HCI_CACHE_HASH_SIZE; i++)
+		INIT_HLIST_HEAD(&hdev->adv_hash[i]);
+	hdev->adv_num = 0;
+	memset(&hdev->adv_stats, 0, sizeof(hdev->adv_stats));
+	hdev->cache_max = HCI_CACHE_MAX_DEFAULT;
 	setup_timer(&hdev->adv_timer, hci_clear_adv_cache,
 						(unsigned long) hdev);
 
@@ -1641,6 +1720,21 @@ int hci_recv_frame(struct sk_buff *skb)
 }
 EXPORT_SYMBOL(hci_recv_frame);
 
+/* Payload length announced by a complete packet header */
+static int hci_reassembly_dlen(int type, void *hdr)
+{
+	switch (type) {
+	case HCI_ACLDATA_PKT:
+		return get_unaligned_le16(&((struct hci_acl_hdr *) hdr)->dlen);
+	case HCI_EVENT_PKT:
+		return ((struct hci_event_hdr *) hdr)->plen;
+	case HCI_SCODATA_PKT:
+		return ((struct hci_sco_hdr *) hdr)->dlen;
+	}
+
+	return 0;
+}
+
 static int hci_reassembly(struct hci_dev *hdev, int type, void *data,
 						  int count, __u8 index)
 {
@@ -1672,6 +1766,11 @@ static int hci_reassembly(struct hci_dev *hdev, int type, void *data,
 			break;
 		}
 
+		/* With the whole header at hand the frame is sized exactly
+		 * instead of for the largest packet of its type */
+		if (count >= hlen)
+			len = min(len, hlen + hci_reassembly_dlen(type, data));
+
 		skb = bt_skb_alloc(len, GFP_ATOMIC);
 		if (!skb)
 			return -ENOMEM;
@@ -1968,6 +2067,80 @@ static void hci_add_acl_hdr(struct sk_buff *skb, __u16 handle, __u16 flags)
 	hdr->dlen   = cpu_to_le16(len);
 }
 
+/* ---- HCI TX scheduler ----
+ *
+ * Every ACL and LE channel with queued data sits on exactly one ready
+ * list of its link type, the one for the priority of its head skb. The
+ * TX task serves the highest non-empty priority round-robin and puts a
+ * channel back at the tail once it has been served, so finding the next
+ * channel to send from does not depend on the number of connections.
+ * The lists are protected by tx_sched_lock, the data queues themselves
+ * are only ever dequeued from the TX task.
+ */
+static inline struct hci_chan_sched *hci_chan_sched(struct hci_dev *hdev,
+								__u8 type)
+{
+	return type == LE_LINK ? &hdev->le_sched : &hdev->acl_sched;
+}
+
+static void __hci_chan_sched_link(struct hci_chan_sched *s,
+						struct hci_chan *chan)
+{
+	struct sk_buff *skb = skb_peek(&chan->data_q);
+
+	if (!skb)
+		return;
+
+	chan->sched_prio = min_t(u32, skb->priority, HCI_PRIO_MAX);
+	list_add_tail(&chan->sched_list, &s->ready[chan->sched_prio]);
+	s->num[chan->sched_prio]++;
+	__set_bit(chan->sched_prio, &s->prio_mask);
+}
+
+static void __hci_chan_sched_unlink(struct hci_chan_sched *s,
+						struct hci_chan *chan)
+{
+	list_del_init(&chan->sched_list);
+	if (!--s->num[chan->sched_prio])
+		__clear_bit(chan->sched_prio, &s->prio_mask);
+}
+
+/* Put a channel that just got data on the ready list if it isn't yet */
+static void hci_chan_sched_queued(struct hci_chan *chan)
+{
+	struct hci_dev *hdev = chan->conn->hdev;
+
+	spin_lock_bh(&hdev->tx_sched_lock);
+	if (list_empty(&chan->sched_list))
+		__hci_chan_sched_link(hci_chan_sched(hdev, chan->conn->type),
+									chan);
+	spin_unlock_bh(&hdev->tx_sched_lock);
+}
+
+/* Move a channel that was just served to the back of its ready list */
+static void hci_chan_sched_served(struct hci_chan *chan)
+{
+	struct hci_dev *hdev = chan->conn->hdev;
+	struct hci_chan_sched *s = hci_chan_sched(hdev, chan->conn->type);
+
+	spin_lock_bh(&hdev->tx_sched_lock);
+	__hci_chan_sched_unlink(s, chan);
+	chan->sched_round = s->round;
+	__hci_chan_sched_link(s, chan);
+	spin_unlock_bh(&hdev->tx_sched_lock);
+}
+
+void hci_chan_sched_unlink(struct hci_chan *chan)
+{
+	struct hci_dev *hdev = chan->conn->hdev;
+
+	spin_lock_bh(&hdev->tx_sched_lock);
+	if (!list_empty(&chan->sched_list))
+		__hci_chan_sched_unlink(hci_chan_sched(hdev, chan->conn->type),
+									chan);
+	spin_unlock_bh(&hdev->tx_sched_lock);
+}
+
 static void hci_queue_acl(struct hci_conn *conn, struct sk_buff_head *queue,
 				struct sk_buff *skb, __u16 flags)
 {
@@ -2021,11 +2194,47 @@ void hci_send_acl(struct hci_chan *chan, struct sk_buff *skb, __u16 flags)
 	hci_add_acl_hdr(skb, conn->handle, flags);
 
 	hci_queue_acl(conn, &chan->data_q, skb, flags);
+	hci_chan_sched_queued(chan);
 
 	tasklet_schedule(&hdev->tx_task);
 }
 EXPORT_SYMBOL(hci_send_acl);
 
+/* Send a list of ACL frames, they reach the channel queue back to back */
+void hci_send_acl_list(struct hci_chan *chan, struct sk_buff_head *list,
+								__u16 flags)
+{
+	struct hci_conn *conn = chan->conn;
+	struct hci_dev *hdev = conn->hdev;
+	struct sk_buff_head frames;
+	struct sk_buff *skb;
+
+	BT_DBG("%s chan %p len %d flags 0x%x", hdev->name, chan,
+						skb_queue_len(list), flags);
+
+	if (skb_queue_empty(list))
+		return;
+
+	skb_queue_head_init(&frames);
+
+	while ((skb = __skb_dequeue(list))) {
+		skb->dev = (void *) hdev;
+		bt_cb(skb)->pkt_type = HCI_ACLDATA_PKT;
+		hci_add_acl_hdr(skb, conn->handle, flags);
+
+		hci_queue_acl(conn, &frames, skb, flags);
+	}
+
+	spin_lock_bh(&chan->data_q.lock);
+	skb_queue_splice_tail_init(&frames, &chan->data_q);
+	spin_unlock_bh(&chan->data_q.lock);
+
+	hci_chan_sched_queued(chan);
+
+	tasklet_schedule(&hdev->tx_task);
+}
+EXPORT_SYMBOL(hci_send_acl_list);
+
 /* Send SCO data */
 void hci_send_sco(struct hci_conn *conn, struct sk_buff *skb)
 {
@@ -2126,56 +2335,38 @@ static inline void hci_link_tx_to(struct hci_dev *hdev, __u8 type)
 static inline struct hci_chan *hci_chan_sent(struct hci_dev *hdev, __u8 type,
 						int *quote)
 {
-	struct hci_conn_hash *h = &hdev->conn_hash;
-	struct hci_chan *chan = NULL;
-	int num = 0, min = ~0, cur_prio = 0;
-	struct hci_conn *conn;
-	int cnt, q, conn_num = 0;
+	struct hci_chan_sched *s = hci_chan_sched(hdev, type);
+	struct hci_chan *chan = NULL, *tmp;
+	unsigned long mask;
+	int prio = 0, num = 0, cnt, q;
 
 	BT_DBG("%s", hdev->name);
 
-	list_for_each_entry(conn, &h->list, list) {
-		struct hci_chan_hash *ch;
-		struct hci_chan *tmp;
-
-		if (conn->type != type)
-			continue;
-
-		if (conn->state != BT_CONNECTED && conn->state != BT_CONFIG)
-			continue;
-
-		conn_num++;
-
-		ch = &conn->chan_hash;
-
-		list_for_each_entry(tmp, &ch->list, list) {
-			struct sk_buff *skb;
-
-			if (skb_queue_empty(&tmp->data_q))
-				continue;
+	spin_lock_bh(&hdev->tx_sched_lock);
 
-			skb = skb_peek(&tmp->data_q);
-			if (skb->priority < cur_prio)
-				continue;
+	s->picks++;
 
-			if (skb->priority > cur_prio) {
-				num = 0;
-				min = ~0;
-				cur_prio = skb->priority;
-			}
+	/* The first channel of the highest priority is normally the one,
+	 * only channels of connections not up yet are passed over. */
+	for (mask = s->prio_mask; mask && !chan; mask &= ~(1UL << prio)) {
+		prio = fls(mask) - 1;
 
-			num++;
+		list_for_each_entry(tmp, &s->ready[prio], sched_list) {
+			s->visits++;
 
-			if (conn->sent < min) {
-				min  = conn->sent;
+			if (tmp->conn->state == BT_CONNECTED ||
+					tmp->conn->state == BT_CONFIG) {
 				chan = tmp;
+				break;
 			}
 		}
-
-		if (hci_conn_num(hdev, type) == conn_num)
-			break;
 	}
 
+	if (chan)
+		num = s->num[prio];
+
+	spin_unlock_bh(&hdev->tx_sched_lock);
+
 	if (!chan)
 		return NULL;
 
@@ -2201,51 +2392,41 @@ static inline struct hci_chan *hci_chan_sent(struct hci_dev *hdev, __u8 type,
 	return chan;
 }
 
+/* Promote the head skb of every channel that waited for a whole round
+ * without being served, so lower priorities are not starved forever. */
 static void hci_prio_recalculate(struct hci_dev *hdev, __u8 type)
 {
-	struct hci_conn_hash *h = &hdev->conn_hash;
-	struct hci_conn *conn;
-	int num = 0;
+	struct hci_chan_sched *s = hci_chan_sched(hdev, type);
+	struct hci_chan *chan, *tmp;
+	int prio;
 
 	BT_DBG("%s", hdev->name);
 
-	list_for_each_entry(conn, &h->list, list) {
-		struct hci_chan_hash *ch;
-		struct hci_chan *chan;
-
-		if (conn->type != type)
-			continue;
-
-		if (conn->state != BT_CONNECTED && conn->state != BT_CONFIG)
-			continue;
-
-		num++;
+	spin_lock_bh(&hdev->tx_sched_lock);
 
-		ch = &conn->chan_hash;
-		list_for_each_entry(chan, &ch->list, list) {
+	for (prio = 0; prio < HCI_PRIO_MAX - 1; prio++) {
+		list_for_each_entry_safe(chan, tmp, &s->ready[prio],
+								sched_list) {
 			struct sk_buff *skb;
 
-			if (chan->sent) {
-				chan->sent = 0;
-				continue;
-			}
-
-			if (skb_queue_empty(&chan->data_q))
+			if (chan->sched_round == s->round)
 				continue;
 
 			skb = skb_peek(&chan->data_q);
-			if (skb->priority >= HCI_PRIO_MAX - 1)
-				continue;
-
 			skb->priority = HCI_PRIO_MAX - 1;
 
+			__hci_chan_sched_unlink(s, chan);
+			__hci_chan_sched_link(s, chan);
+			s->promotions++;
+
 			BT_DBG("chan %p skb %p promoted to %d", chan, skb,
 								skb->priority);
 		}
-
-		if (hci_conn_num(hdev, type) == num)
-			break;
 	}
+
+	s->round++;
+
+	spin_unlock_bh(&hdev->tx_sched_lock);
 }
 
 static inline void hci_sched_acl(struct hci_dev *hdev)
@@ -2289,9 +2470,10 @@ static inline void hci_sched_acl(struct hci_dev *hdev)
 			hdev->acl_last_tx = jiffies;
 
 			hdev->acl_cnt--;
-			chan->sent++;
 			chan->conn->sent++;
 		}
+
+		hci_chan_sched_served(chan);
 	}
 
 	if (cnt != hdev->acl_cnt)
@@ -2382,9 +2564,10 @@ static inline void hci_sched_le(struct hci_dev *hdev)
 			hdev->le_last_tx = jiffies;
 
 			cnt--;
-			chan->sent++;
 			chan->conn->sent++;
 		}
+
+		hci_chan_sched_served(chan);
 	}
 
 	if (hdev->le_pkts)
@@ -417,7 +417,7 @@ static int inquiry_cache_show(struct seq_file *f, void *p)
 
 	hci_dev_lock_bh(hdev);
 
-	for (e = cache->list; e; e = e->next) {
+	list_for_each_entry(e, &cache->list, list) {
 		struct inquiry_data *data = &e->data;
 		seq_printf(f, "%s %d %d %d 0x%.2x%.2x%.2x 0x%.4x %d %d %u\n",
 			   batostr(&data->bdaddr),
@@ -516,6 +516,48 @@ static const struct file_operations uuids_fops = {
 	.release	= single_release,
 };
 
+static void tx_sched_show_one(struct seq_file *f, const char *name,
+				unsigned int conns, struct hci_chan_sched *s)
+{
+	int i;
+
+	seq_printf(f, "%s conns %u picks %lu visits %lu promotions %lu ready",
+				name, conns, s->picks, s->visits, s->promotions);
+
+	for (i = 0; i <= HCI_PRIO_MAX; i++)
+		seq_printf(f, " %u", s->num[i]);
+
+	seq_printf(f, "\n");
+}
+
+static int tx_sched_show(struct seq_file *f, void *p)
+{
+	struct hci_dev *hdev = f->private;
+
+	spin_lock_bh(&hdev->tx_sched_lock);
+
+	tx_sched_show_one(f, "acl", hdev->conn_hash.acl_num, &hdev->acl_sched);
+	tx_sched_show_one(f, "le", hdev->conn_hash.le_num, &hdev->le_sched);
+
+	spin_unlock_bh(&hdev->tx_sched_lock);
+
+	seq_printf(f, "sco conns %u\n", hdev->conn_hash.sco_num);
+
+	return 0;
+}
+
+static int tx_sched_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, tx_sched_show, inode->i_private);
+}
+
+static const struct file_operations tx_sched_fops = {
+	.open		= tx_sched_open,
+	.read		= seq_read,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+
 static int auto_accept_delay_set(void *data, u64 val)
 {
 	struct hci_dev *hdev = data;
@@ -545,6 +587,73 @@ static int auto_accept_delay_get(void *data, u64 *val)
 DEFINE_SIMPLE_ATTRIBUTE(auto_accept_delay_fops, auto_accept_delay_get,
 					auto_accept_delay_set, "%llu\n");
 
+static int cache_max_set(void *data, u64 val)
+{
+	struct hci_dev *hdev = data;
+
+	if (val < 1 || val > UINT_MAX)
+		return -EINVAL;
+
+	hci_dev_lock_bh(hdev);
+
+	hdev->cache_max = val;
+
+	hci_dev_unlock_bh(hdev);
+
+	return 0;
+}
+
+static int cache_max_get(void *data, u64 *val)
+{
+	struct hci_dev *hdev = data;
+
+	hci_dev_lock_bh(hdev);
+
+	*val = hdev->cache_max;
+
+	hci_dev_unlock_bh(hdev);
+
+	return 0;
+}
+
+DEFINE_SIMPLE_ATTRIBUTE(cache_max_fops, cache_max_get, cache_max_set,
+								"%llu\n");
+
+static void cache_stats_show_one(struct seq_file *f, const char *name,
+			unsigned int num, struct hci_cache_stats *stats)
+{
+	seq_printf(f, "%s entries %u hits %lu misses %lu evictions %lu\n",
+				name, num, stats->hits, stats->misses,
+				stats->evictions);
+}
+
+static int cache_stats_show(struct seq_file *f, void *p)
+{
+	struct hci_dev *hdev = f->private;
+
+	hci_dev_lock_bh(hdev);
+
+	cache_stats_show_one(f, "inquiry", hdev->inq_cache.num,
+						&hdev->inq_cache.stats);
+	cache_stats_show_one(f, "adv", hdev->adv_num, &hdev->adv_stats);
+
+	hci_dev_unlock_bh(hdev);
+
+	return 0;
+}
+
+static int cache_stats_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, cache_stats_show, inode->i_private);
+}
+
+static const struct file_operations cache_stats_fops = {
+	.open		= cache_stats_open,
+	.read		= seq_read,
+	.llseek		= seq_lseek,
+	.release	= single_release,
+};
+
 void hci_init_sysfs(struct hci_dev *hdev)
 {
 	struct device *dev = &hdev->dev;
@@ -585,6 +694,15 @@ int hci_add_sysfs(struct hci_dev *hdev)
 
 	debugfs_create_file("uuids", 0444, hdev->debugfs, hdev, &uuids_fops);
 
+	debugfs_create_file("tx_sched", 0444, hdev->debugfs, hdev,
+							&tx_sched_fops);
+
+	debugfs_create_file("cache_max", 0644, hdev->debugfs, hdev,
+							&cache_max_fops);
+
+	debugfs_create_file("cache_stats", 0444, hdev->debugfs, hdev,
+							&cache_stats_fops);
+
 	debugfs_create_file("auto_accept_delay", 0444, hdev->debugfs, hdev,
 						&auto_accept_delay_fops);
 	return 0;
@@ -571,22 +571,33 @@ static void l2cap_send_cmd(struct l2cap_conn *conn, u8 ident, u8 code, u16 len,
 	hci_send_acl(conn->hchan, skb, flags);
 }
 
-static void l2cap_do_send(struct l2cap_chan *chan, struct sk_buff *skb)
+static inline u16 l2cap_acl_flags(struct l2cap_chan *chan)
 {
 	struct hci_conn *hcon = chan->conn->hcon;
-	u16 flags;
-
-	BT_DBG("chan %p, skb %p len %d priority %u", chan, skb, skb->len,
-							skb->priority);
 
 	if (!test_bit(FLAG_FLUSHABLE, &chan->flags) &&
 					lmp_no_flush_capable(hcon->hdev))
-		flags = ACL_START_NO_FLUSH;
-	else
-		flags = ACL_START;
+		return ACL_START_NO_FLUSH;
+
+	return ACL_START;
+}
+
+static void l2cap_do_send(struct l2cap_chan *chan, struct sk_buff *skb)
+{
+	BT_DBG("chan %p, skb %p len %d priority %u", chan, skb, skb->len,
+							skb->priority);
 
 	bt_cb(skb)->force_active = test_bit(FLAG_FORCE_ACTIVE, &chan->flags);
-	hci_send_acl(chan->conn->hchan, skb, flags);
+	hci_send_acl(chan->conn->hchan, skb, l2cap_acl_flags(chan));
+}
+
+/* Hand a batch of frames, already marked force_active, to HCI at once */
+static void l2cap_do_send_list(struct l2cap_chan *chan,
+						struct sk_buff_head *list)
+{
+	BT_DBG("chan %p, len %d", chan, skb_queue_len(list));
+
+	hci_send_acl_list(chan->conn->hchan, list, l2cap_acl_flags(chan));
 }
 
 static inline void l2cap_send_sframe(struct l2cap_chan *chan, u32 control)
@@ -1286,10 +1297,13 @@ static void l2cap_drop_acked_frames(struct l2cap_chan *chan)
 
 static void l2cap_streaming_send(struct l2cap_chan *chan)
 {
+	struct sk_buff_head frames;
 	struct sk_buff *skb;
 	u32 control;
 	u16 fcs;
 
+	__skb_queue_head_init(&frames);
+
 	while ((skb = skb_dequeue(&chan->tx_q))) {
 		control = __get_control(chan, skb->data + L2CAP_HDR_SIZE);
 		control |= __set_txseq(chan, chan->next_tx_seq);
@@ -1302,10 +1316,14 @@ static void l2cap_streaming_send(struct l2cap_chan *chan)
 					skb->data + skb->len - L2CAP_FCS_SIZE);
 		}
 
-		l2cap_do_send(chan, skb);
+		bt_cb(skb)->force_active = test_bit(FLAG_FORCE_ACTIVE,
+								&chan->flags);
+		__skb_queue_tail(&frames, skb);
 
 		chan->next_tx_seq = __next_seq(chan, chan->next_tx_seq);
 	}
+
+	l2cap_do_send_list(chan, &frames);
 }
 
 static void l2cap_retransmit_one_frame(struct l2cap_chan *chan, u16 tx_seq)
@@ -1359,6 +1377,7 @@ static void l2cap_retransmit_one_frame(struct l2cap_chan *chan, u16 tx_seq)
 
 static int l2cap_ertm_send(struct l2cap_chan *chan)
 {
+	struct sk_buff_head frames;
 	struct sk_buff *skb, *tx_skb;
 	u16 fcs;
 	u32 control;
@@ -1367,15 +1386,21 @@ static int l2cap_ertm_send(struct l2cap_chan *chan)
 	if (chan->state != BT_CONNECTED)
 		return -ENOTCONN;
 
+	__skb_queue_head_init(&frames);
+
 	while ((skb = chan->tx_send_head) && (!l2cap_tx_window_full(chan))) {
 
 		if (chan->remote_max_tx &&
 				bt_cb(skb)->retries == chan->remote_max_tx) {
+			/* what is already in the window goes out first */
+			l2cap_do_send_list(chan, &frames);
 			l2cap_send_disconn_req(chan->conn, chan, ECONNABORTED);
 			break;
 		}
 
 		tx_skb = skb_clone(skb, GFP_ATOMIC);
+		if (!tx_skb)
+			break;
 
 		bt_cb(skb)->retries++;
 
@@ -1397,7 +1422,9 @@ static int l2cap_ertm_send(struct l2cap_chan *chan)
 						tx_skb->len - L2CAP_FCS_SIZE);
 		}
 
-		l2cap_do_send(chan, tx_skb);
+		bt_cb(tx_skb)->force_active = test_bit(FLAG_FORCE_ACTIVE,
+								&chan->flags);
+		__skb_queue_tail(&frames, tx_skb);
 
 		__set_retrans_timer(chan);
 
@@ -1418,6 +1445,8 @@ static int l2cap_ertm_send(struct l2cap_chan *chan)
 		nsent++;
 	}
 
+	l2cap_do_send_list(chan, &frames);
+
 	return nsent;
 }
 
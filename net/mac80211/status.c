@@ -40,6 +40,55 @@ void ieee80211_tx_status_irqsafe(struct ieee80211_hw *hw,
 }
 EXPORT_SYMBOL(ieee80211_tx_status_irqsafe);
 
+void ieee80211_tx_status_irqsafe_list(struct ieee80211_hw *hw,
+				      struct sk_buff_head *skbs)
+{
+	struct ieee80211_local *local = hw_to_local(hw);
+	struct sk_buff_head reliable, unreliable;
+	struct ieee80211_tx_info *info;
+	struct sk_buff *skb;
+	unsigned long flags;
+	int tmp;
+
+	if (skb_queue_empty(skbs))
+		return;
+
+	__skb_queue_head_init(&reliable);
+	__skb_queue_head_init(&unreliable);
+
+	while ((skb = __skb_dequeue(skbs))) {
+		info = IEEE80211_SKB_CB(skb);
+		skb->pkt_type = IEEE80211_TX_STATUS_MSG;
+		__skb_queue_tail(info->flags & IEEE80211_TX_CTL_REQ_TX_STATUS ?
+				 &reliable : &unreliable, skb);
+	}
+
+	if (!skb_queue_empty(&reliable)) {
+		spin_lock_irqsave(&local->skb_queue.lock, flags);
+		skb_queue_splice_tail_init(&reliable, &local->skb_queue);
+		spin_unlock_irqrestore(&local->skb_queue.lock, flags);
+	}
+
+	if (!skb_queue_empty(&unreliable)) {
+		spin_lock_irqsave(&local->skb_queue_unreliable.lock, flags);
+		skb_queue_splice_tail_init(&unreliable,
+					   &local->skb_queue_unreliable);
+		spin_unlock_irqrestore(&local->skb_queue_unreliable.lock,
+				       flags);
+	}
+
+	tmp = skb_queue_len(&local->skb_queue) +
+		skb_queue_len(&local->skb_queue_unreliable);
+	while (tmp > IEEE80211_IRQSAFE_QUEUE_LIMIT &&
+	       (skb = skb_dequeue(&local->skb_queue_unreliable))) {
+		dev_kfree_skb_irq(skb);
+		tmp--;
+		I802_DEBUG_INC(local->tx_status_drop);
+	}
+	tasklet_schedule(&local->tasklet);
+}
+EXPORT_SYMBOL(ieee80211_tx_status_irqsafe_list);
+
 static void ieee80211_handle_filtered_frame(struct ieee80211_local *local,
 					    struct sta_info *sta,
 					    struct sk_buff *skb)
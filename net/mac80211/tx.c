@@ -2151,12 +2151,32 @@ void ieee80211_tx_pending(unsigned long data)
 		while (!skb_queue_empty(&local->pending[i])) {
 			struct sk_buff *skb = __skb_dequeue(&local->pending[i]);
 			struct ieee80211_tx_info *info = IEEE80211_SKB_CB(skb);
+			struct sk_buff *next = skb_peek(&local->pending[i]);
 
 			if (WARN_ON(!info->control.vif)) {
 				kfree_skb(skb);
 				continue;
 			}
 
+			/*
+			 * Tell the driver whether more frames follow, so it
+			 * only needs to kick the DMA queue once per batch.
+			 * Only promise that when the next frame goes straight
+			 * to the driver: the tx handlers may buffer or drop a
+			 * frame that still needs processing, and a stopped
+			 * queue makes the next frame stay here. In the rare
+			 * case the queue is stopped right after this check,
+			 * the batch is finished when the queue is woken again.
+			 * The flag is recomputed each time since it may have
+			 * been set when the frame was requeued.
+			 */
+			if (next && !local->queue_stop_reasons[i] &&
+			    !(IEEE80211_SKB_CB(next)->flags &
+			      IEEE80211_TX_INTFL_NEED_TXPROCESSING))
+				info->flags |= IEEE80211_TX_CTL_MORE_FRAMES;
+			else
+				info->flags &= ~IEEE80211_TX_CTL_MORE_FRAMES;
+
 			spin_unlock_irqrestore(&local->queue_stop_reason_lock,
 						flags);
 